@@ -0,0 +1,153 @@
+/**
+ * Controller cache scaling benchmark
+ *
+ * Measures get/put throughput of a single LRUCache behind one global mutex
+ * against the sharded ConcurrentLRUCache, from 1 to 32 threads.
+ * Workload: skewed keys (80% of requests hit 1/8 of the titles), 99% get,
+ * 1% put of a new track. Tracks for puts are built before timing starts.
+ *
+ * Build and run: make bench-cache
+ */
+#include "ConcurrentLRUCache.h"
+#include "Logger.h"
+#include "LRUCache.h"
+#include "MP3Track.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t KEYSPACE = 8192;
+const size_t CAPACITY = 4096;
+const size_t SHARDS = 64;
+const size_t TOTAL_OPS = 1000000;
+const unsigned PUT_PERCENT = 1;
+
+std::vector<std::string> titles;
+
+struct XorShift {
+    uint64_t state;
+    explicit XorShift(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+size_t pick_key(XorShift& rng) {
+    uint64_t r = rng.next();
+    if (r % 10 < 8) return (r >> 8) % (KEYSPACE / 8);
+    return (r >> 8) % KEYSPACE;
+}
+
+PointerWrapper<AudioTrack> make_track(const std::string& title) {
+    return PointerWrapper<AudioTrack>(new MP3Track(title, {"Bench Artist"}, 240, 128, 320));
+}
+
+/**
+ * Single LRUCache guarded by one mutex: the baseline sharing strategy.
+ */
+struct GlobalLockCache {
+    std::mutex lock;
+    LRUCache cache;
+    GlobalLockCache() : lock(), cache(CAPACITY) {}
+
+    AudioTrack* get(const std::string& key) {
+        std::lock_guard<std::mutex> guard(lock);
+        return cache.get(key);
+    }
+    bool put(PointerWrapper<AudioTrack> track) {
+        std::lock_guard<std::mutex> guard(lock);
+        return cache.put(std::move(track));
+    }
+};
+
+template<typename Cache>
+void prefill(Cache& cache) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        cache.put(make_track(titles[i]));
+    }
+}
+
+template<typename Cache>
+double run(Cache& cache, size_t threads) {
+    size_t ops_per_thread = TOTAL_OPS / threads;
+
+    // Pre-build the tracks each thread will insert so timing covers cache work only
+    std::vector<std::vector<PointerWrapper<AudioTrack> > > pools(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        XorShift rng(t + 1);
+        for (size_t i = 0; i < ops_per_thread * PUT_PERCENT / 100 + 1; ++i) {
+            pools[t].push_back(make_track(titles[pick_key(rng)]));
+        }
+    }
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&cache, &pools, t, ops_per_thread]() {
+            XorShift rng(1000 + t);
+            std::vector<PointerWrapper<AudioTrack> >& pool = pools[t];
+            size_t next_put = 0;
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                if (rng.next() % 100 < PUT_PERCENT && next_put < pool.size()) {
+                    cache.put(std::move(pool[next_put++]));
+                } else {
+                    cache.get(titles[pick_key(rng)]);
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return (ops_per_thread * threads) / seconds;
+}
+
+}  // namespace
+
+int main() {
+    // Track constructors log; keep the report readable
+    Logger::set_quiet(true);
+    std::ostream& report = std::cout;
+
+    for (size_t i = 0; i < KEYSPACE; ++i) {
+        titles.push_back("Bench Track " + std::to_string(i));
+    }
+
+    report << "Controller cache scaling: capacity " << CAPACITY << ", keyspace " << KEYSPACE
+           << ", " << SHARDS << " shards, " << TOTAL_OPS << " ops, " << PUT_PERCENT << "% put\n";
+    report << std::setw(8) << "threads" << std::setw(18) << "global Mops/s"
+           << std::setw(18) << "sharded Mops/s" << std::setw(12) << "speedup" << "\n";
+
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32};
+    double sharded_single = 0;
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i) {
+        size_t threads = thread_counts[i];
+
+        GlobalLockCache global;
+        prefill(global.cache);
+        double global_ops = run(global, threads);
+
+        ConcurrentLRUCache sharded(CAPACITY, SHARDS);
+        prefill(sharded);
+        double sharded_ops = run(sharded, threads);
+        if (threads == 1) sharded_single = sharded_ops;
+
+        report << std::setw(8) << threads
+               << std::setw(18) << std::fixed << std::setprecision(2) << global_ops / 1e6
+               << std::setw(18) << sharded_ops / 1e6
+               << std::setw(11) << sharded_ops / sharded_single << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,722 @@
+/**
+ * Microbenchmark suite for the track pipeline hot paths
+ *
+ * Cases:
+ * - cache/get_or_put     LRUCache get, put on miss; capacities x hit ratios
+ * - track/clone          AudioTrack::clone across waveform sizes
+ * - track/clone_write    clone plus the first write (copy-on-write detach)
+ * - playlist/add_track   Playlist::add_track, 10 to 100k entries (per add)
+ * - playlist/find_track  Playlist::find_track, 10 to 100k entries
+ * - parser/parse_config  SessionFileParser::parse_config_file on configs from
+ *                        LibraryGenerator, stream, mapped and parallel modes
+ *                        (per track line)
+ * - mixer/load_to_deck   MixingEngineService::loadTrackToDeck
+ * - mixer/transition     Per-transition latency until the new deck's samples
+ *                        are readable, with and without preloadTrack();
+ *                        percentiles (pct=50/95/99/100) instead of medians
+ * - mixer/render         MixingEngineService::renderBlock, both decks playing,
+ *                        block sizes 64 to 4096 frames (per output frame)
+ * - mixer/render_thread  Frames read from the render thread (startRenderThread,
+ *                        256-frame blocks), both decks playing; includes the
+ *                        handoff through the output ring and the render
+ *                        thread's idle wait when the ring is full (per frame)
+ * - mixer/spsc_ring      SpscRing push then pop of one 8-byte item, and of
+ *                        512-float blocks (per item)
+ * - mixer/kernel         MixKernels mix2/add/clip at every SIMD level the CPU
+ *                        supports, 1024 frames (per output frame)
+ * - stretch/wsola        TimeStretcher at tempo ratios 0.9 to 1.5, 512-frame
+ *                        blocks (per output frame; also printed as realtime
+ *                        multiples of one 44.1 kHz deck per core)
+ * - analysis/beat_track  BeatTracker::analyze on a 30 s, 44.1 kHz lazy waveform
+ *                        (per input sample; also printed as realtime multiples)
+ * - analysis/cache_hit   AnalysisCache::analyze for an already analyzed
+ *                        waveform (memoized content hash plus map lookup)
+ * - library/bpm_*        BpmIndex count, range and nearest-BPM queries over
+ *                        1M tracks (10 results, +/-6 BPM, with filters)
+ * - search/...           TrackSearchIndex word, prefix, multi-artist and
+ *                        autocomplete queries over 1M tracks (20 results)
+ *
+ * Each case is calibrated to run at least MIN_RUN_NS, then repeated
+ * REPETITIONS times; the median ns/op is reported. Allocations are counted
+ * by replacing global operator new in this binary. Logging runs in quiet
+ * mode, so formatting console output is not part of the numbers.
+ *
+ * Usage: micro_bench [--json=path] [--filter=substring]
+ * Build and run: make bench (JSON goes to bin/bench_results.json)
+ */
+#include "AnalysisCache.h"
+#include "AudioTrack.h"
+#include "BeatTracker.h"
+#include "BpmIndex.h"
+#include "LRUCache.h"
+#include "LibraryGenerator.h"
+#include "Logger.h"
+#include "MP3Track.h"
+#include "MixKernels.h"
+#include "MixingEngineService.h"
+#include "Playlist.h"
+#include "SessionFileParser.h"
+#include "SpscRing.h"
+#include "TimeStretcher.h"
+#include "TrackSearchIndex.h"
+#include "WAVTrack.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ========== ALLOCATION COUNTING ==========
+
+namespace {
+std::atomic<uint64_t> allocation_count(0);
+}
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ========== HARNESS ==========
+
+const uint64_t MIN_RUN_NS = 20000000;  // 20 ms per timed repetition
+const int REPETITIONS = 5;
+
+struct Result {
+    std::string name;
+    std::string params;       // "key=value,key=value"
+    double ns_per_op;
+    double allocs_per_op;
+    uint64_t ops;             // ops per repetition
+
+    Result(const std::string& name, const std::string& params, double ns_per_op,
+           double allocs_per_op, uint64_t ops)
+        : name(name), params(params), ns_per_op(ns_per_op), allocs_per_op(allocs_per_op), ops(ops) {}
+};
+
+std::vector<Result> results;
+std::string filter;
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool selected(const std::string& name, const std::string& params) {
+    return filter.empty() || (name + "/" + params).find(filter) != std::string::npos;
+}
+
+void report(const Result& result) {
+    results.push_back(result);
+    std::cout << std::left << std::setw(22) << result.name << std::setw(30) << result.params << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << result.ns_per_op
+              << std::setw(14) << std::setprecision(2) << result.allocs_per_op << std::endl;
+}
+
+/**
+ * @param body Runs `iterations` iterations of the case
+ * @param ops_per_iteration Operations one iteration counts as
+ */
+void run_case(const std::string& name, const std::string& params,
+              const std::function<void(uint64_t)>& body, uint64_t ops_per_iteration = 1) {
+    if (!selected(name, params)) {
+        return;
+    }
+
+    // Calibrate: double the iteration count until one run takes MIN_RUN_NS
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t start = now_ns();
+        body(iterations);
+        uint64_t elapsed = now_ns() - start;
+        if (elapsed >= MIN_RUN_NS || iterations >= (uint64_t(1) << 40)) break;
+        if (elapsed < MIN_RUN_NS / 64) iterations *= 16;
+        else iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    uint64_t allocations = 0;
+    for (int r = 0; r < REPETITIONS; ++r) {
+        uint64_t alloc_before = allocation_count.load(std::memory_order_relaxed);
+        uint64_t start = now_ns();
+        body(iterations);
+        uint64_t elapsed = now_ns() - start;
+        allocations = allocation_count.load(std::memory_order_relaxed) - alloc_before;
+        samples.push_back(static_cast<double>(elapsed) / (iterations * ops_per_iteration));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    uint64_t ops = iterations * ops_per_iteration;
+    report(Result(name, params, samples[samples.size() / 2],
+                  static_cast<double>(allocations) / ops, ops));
+}
+
+struct XorShift {
+    uint64_t state;
+    explicit XorShift(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/**
+ * Minimal concrete track with a configurable waveform length
+ */
+class BenchTrack : public AudioTrack {
+public:
+    BenchTrack(const std::string& title, size_t samples)
+        : AudioTrack(title, {"Bench Artist"}, 240, 128, samples) {}
+    void load() override {}
+    void analyze_beatgrid() override {}
+    double get_quality_score() const override { return 100.0; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+std::vector<std::string> make_titles(size_t count) {
+    std::vector<std::string> titles;
+    titles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        titles.push_back("Bench Track " + std::to_string(i));
+    }
+    return titles;
+}
+
+std::vector<TrackHandle> make_handles(const std::vector<std::string>& titles) {
+    std::vector<TrackHandle> handles;
+    handles.reserve(titles.size());
+    for (size_t i = 0; i < titles.size(); ++i) {
+        handles.push_back(TrackHandle(new MP3Track(titles[i], {"Bench Artist"}, 240, 128, 320)));
+    }
+    return handles;
+}
+
+// ========== CASES ==========
+
+void bench_cache() {
+    const size_t capacities[] = {16, 256, 4096};
+    const double hit_ratios[] = {0.5, 0.9, 0.99};
+    for (size_t capacity : capacities) {
+        for (double hit_ratio : hit_ratios) {
+            // Uniform keys over capacity / hit_ratio titles give about hit_ratio hits
+            size_t keyspace = static_cast<size_t>(capacity / hit_ratio + 0.5);
+            std::vector<std::string> titles = make_titles(keyspace);
+            std::vector<TrackHandle> handles = make_handles(titles);
+            LRUCache cache(capacity);
+            XorShift rng(capacity);
+            for (size_t i = 0; i < keyspace; ++i) cache.put(handles[i]);
+
+            std::ostringstream params;
+            params << "capacity=" << capacity << ",hit_ratio=" << hit_ratio;
+            run_case("cache/get_or_put", params.str(), [&](uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; ++i) {
+                    size_t key = rng.next() % keyspace;
+                    if (!cache.get(titles[key])) cache.put(handles[key]);
+                }
+            });
+        }
+    }
+}
+
+void bench_clone() {
+    const size_t sizes[] = {1000, 44100, 441000};
+    for (size_t samples : sizes) {
+        BenchTrack track("Clone Source", samples);
+        double first = 0;
+        track.get_waveform_copy(&first, 1);  // generate the samples up front
+
+        std::string params = "waveform_samples=" + std::to_string(samples);
+        run_case("track/clone", params, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                PointerWrapper<AudioTrack> copy = track.clone();
+            }
+        });
+        run_case("track/clone_write", params, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                PointerWrapper<AudioTrack> copy = track.clone();
+                copy->get_mutable_waveform()[0] = 0.0;
+            }
+        });
+    }
+}
+
+void bench_playlist() {
+    const size_t sizes[] = {10, 100, 1000, 10000, 100000};
+    for (size_t size : sizes) {
+        std::vector<std::string> titles = make_titles(size);
+        std::vector<TrackHandle> handles = make_handles(titles);
+        std::string params = "entries=" + std::to_string(size);
+
+        // Per add, amortized over building a whole playlist
+        run_case("playlist/add_track", params, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                Playlist playlist("Bench");
+                for (size_t t = 0; t < size; ++t) playlist.add_track(handles[t]);
+            }
+        }, size);
+
+        Playlist playlist("Bench");
+        for (size_t t = 0; t < size; ++t) playlist.add_track(handles[t]);
+        XorShift rng(size);
+        run_case("playlist/find_track", params, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                if (!playlist.find_track(titles[rng.next() % size])) std::abort();
+            }
+        });
+    }
+}
+
+void bench_parser() {
+    const size_t sizes[] = {1000, 10000, 100000};
+    for (size_t tracks : sizes) {
+        std::string path = "bin/bench_config_" + std::to_string(tracks) + ".txt";
+        LibraryGenerator::Options options;
+        options.tracks = tracks;
+        options.playlists = tracks / 100;
+        if (!LibraryGenerator::write_config(path, options)) std::abort();
+
+        // Per track line
+        const ParserMode modes[] = {ParserMode::Stream, ParserMode::Mapped, ParserMode::Parallel};
+        const char* mode_names[] = {"mode=stream", "mode=mapped", "mode=parallel"};
+        for (size_t m = 0; m < 3; ++m) {
+            SessionFileParser::set_parser_mode(modes[m]);
+            std::string params = std::string(mode_names[m]) + ",tracks=" + std::to_string(tracks);
+            run_case("parser/parse_config", params, [&](uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; ++i) {
+                    SessionConfig config;
+                    if (!SessionFileParser::parse_config_file(path, config)) std::abort();
+                }
+            }, tracks);
+        }
+        SessionFileParser::set_parser_mode(ParserMode::Parallel);
+        std::remove(path.c_str());
+    }
+}
+
+void bench_bpm_index() {
+    // Synthetic entries: BPM spread like LibraryGenerator output (90-169)
+    const size_t tracks = 1000000;
+    XorShift rng(16);
+    std::vector<BpmIndex::Entry> entries(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        entries[i].library_index = static_cast<uint32_t>(i);
+        entries[i].bpm = 90 + static_cast<int>(rng.next() % 80);
+        entries[i].quality = static_cast<float>(rng.next() % 101);
+        entries[i].kind = rng.next() % 3 ? TrackKind::MP3 : TrackKind::WAV;
+    }
+    BpmIndex index;
+    index.build(entries);
+
+    std::vector<uint32_t> out;
+    out.reserve(16);
+    std::string params = "tracks=" + std::to_string(tracks);
+    run_case("library/bpm_count", params, [&](uint64_t iterations) {
+        size_t total = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            int bpm = 90 + static_cast<int>(rng.next() % 80);
+            total += index.count(bpm - 6, bpm + 6);
+        }
+        if (total == 0) std::abort();
+    });
+
+    const BpmIndex::Filter filters[] = {BpmIndex::Filter(), BpmIndex::Filter(TrackKind::WAV, 80.0)};
+    const char* filter_names[] = {",filter=none", ",filter=wav_q80"};
+    for (size_t f = 0; f < 2; ++f) {
+        run_case("library/bpm_range", params + filter_names[f], [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                int bpm = 90 + static_cast<int>(rng.next() % 80);
+                out.clear();
+                if (!index.find_range(bpm - 6, bpm + 6, filters[f], 10, out)) std::abort();
+            }
+        });
+        run_case("library/bpm_nearest", params + filter_names[f], [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                int bpm = 90 + static_cast<int>(rng.next() % 80);
+                out.clear();
+                if (!index.find_nearest(bpm, 10, 6, filters[f], out)) std::abort();
+            }
+        });
+    }
+}
+
+void bench_search_index() {
+    // Titles of two to four words from a small vocabulary plus a number;
+    // one or two of 20k artists per track
+    static const char* words[] = {"love", "night", "dance", "fire", "summer", "heart", "light", "dream",
+                                  "city", "gold", "wild", "blue", "rain", "star", "echo", "river"};
+    const size_t tracks = 1000000;
+    XorShift rng(17);
+    TrackSearchIndex index;
+    for (size_t i = 0; i < tracks; ++i) {
+        std::string title;
+        size_t word_count = 2 + rng.next() % 3;
+        for (size_t w = 0; w < word_count; ++w) title += std::string(words[rng.next() % 16]) + " ";
+        title += std::to_string(i);
+        std::vector<std::string> artists(1, "Artist " + std::to_string(rng.next() % 20000));
+        if (rng.next() % 4 == 0) artists.push_back("Guest " + std::to_string(rng.next() % 500));
+        index.add(static_cast<uint32_t>(i), title, artists);
+    }
+    index.sort_vocabulary();    // outside the timed runs
+
+    std::string params = "tracks=" + std::to_string(tracks);
+    const char* queries[] = {"summer night", "summer ni", "123", "artist 42"};
+    const char* query_names[] = {",query=words", ",query=prefix", ",query=number_prefix", ",query=artist"};
+    for (size_t q = 0; q < 4; ++q) {
+        std::string query = queries[q];
+        run_case("search/query", params + query_names[q], [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                if (index.search(query).empty()) std::abort();
+            }
+        });
+    }
+    std::vector<std::string> pair;
+    pair.push_back("Artist 7");
+    pair.push_back("Guest 3");
+    run_case("search/artists", params + ",artists=2", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            index.find_by_artists(pair);
+        }
+    });
+    run_case("search/complete", params + ",prefix=ri", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            if (index.complete("ri").empty()) std::abort();
+        }
+    });
+}
+
+void bench_mixer() {
+    std::vector<PointerWrapper<AudioTrack> > pool;
+    for (int i = 0; i < 64; ++i) {
+        std::string title = "Deck Track " + std::to_string(i);
+        if (i % 2) pool.push_back(PointerWrapper<AudioTrack>(new WAVTrack(title, {"Bench Artist"}, 300, 120 + i % 8, 44100, 16)));
+        else pool.push_back(PointerWrapper<AudioTrack>(new MP3Track(title, {"Bench Artist"}, 300, 120 + i % 8, 320)));
+    }
+    MixingEngineService mixer;
+    mixer.set_auto_sync(true);
+    mixer.set_bpm_tolerance(10);
+    size_t next = 0;
+    run_case("mixer/load_to_deck", "auto_sync=1", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            mixer.loadTrackToDeck(*pool[next++ % pool.size()]);
+        }
+    });
+}
+
+/**
+ * Each transition is timed on its own: loadTrackToDeck plus the first read of
+ * the new deck's samples (what playback needs). Between transitions the deck
+ * "plays" for PLAY_TIME, which is when the preload worker runs.
+ */
+void bench_transition() {
+    const size_t TRANSITIONS = 400;
+    const size_t SAMPLES = 1 << 16;
+    const std::chrono::milliseconds PLAY_TIME(2);
+    const int percentiles[] = {50, 95, 99, 100};
+
+    for (int preload = 0; preload <= 1; ++preload) {
+        std::string mode = preload ? "preload=1" : "preload=0";
+        if (!selected("mixer/transition", mode + ",pct=")) {
+            continue;
+        }
+        std::vector<TrackHandle> tracks;
+        for (size_t i = 0; i < TRANSITIONS + 1; ++i) {
+            // Distinct titles: every track generates its own samples
+            std::string title = "Transition " + std::to_string(preload) + "/" + std::to_string(i);
+            tracks.push_back(TrackHandle(new BenchTrack(title, SAMPLES)));
+        }
+
+        MixingEngineService mixer;
+        mixer.setRenderingEnabled(true);
+        mixer.loadTrackToDeck(*tracks[0]);
+        std::vector<double> latencies;
+        uint64_t allocations = 0;
+        for (size_t i = 1; i <= TRANSITIONS; ++i) {
+            if (preload) {
+                mixer.preloadTrack(tracks[i]);
+            }
+            std::this_thread::sleep_for(PLAY_TIME);
+
+            uint64_t alloc_before = allocation_count.load(std::memory_order_relaxed);
+            uint64_t start = now_ns();
+            mixer.loadTrackToDeck(*tracks[i]);
+            mixer.getDeckTrack(mixer.getActiveDeck())->get_waveform_data();
+            latencies.push_back(static_cast<double>(now_ns() - start));
+            allocations += allocation_count.load(std::memory_order_relaxed) - alloc_before;
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        for (int pct : percentiles) {
+            size_t rank = std::min(latencies.size() - 1, latencies.size() * pct / 100);
+            report(Result("mixer/transition", mode + ",pct=" + std::to_string(pct), latencies[rank],
+                          static_cast<double>(allocations) / TRANSITIONS, TRANSITIONS));
+        }
+    }
+}
+
+void bench_render() {
+    const size_t SAMPLES = 1 << 20;
+    BenchTrack deck_a("Render A", SAMPLES);
+    BenchTrack deck_b("Render B", SAMPLES);
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.loadTrackToDeck(deck_a);
+    mixer.loadTrackToDeck(deck_b);
+    mixer.setCrossfader(0.3f);
+
+    const size_t block_sizes[] = {64, 256, 1024, 4096};
+    std::vector<float> out(MixingEngineService::MAX_BLOCK_FRAMES * MixingEngineService::OUTPUT_CHANNELS);
+    for (size_t frames : block_sizes) {
+        run_case("mixer/render", "frames=" + std::to_string(frames), [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                if (mixer.getDeckPosition(0) + frames > SAMPLES) {
+                    mixer.setDeckPosition(0, 0);
+                    mixer.setDeckPosition(1, 0);
+                }
+                mixer.renderBlock(out.data(), frames);
+            }
+        }, frames);
+    }
+}
+
+void bench_render_thread() {
+    const size_t SAMPLES = 1 << 20;
+    const size_t FRAMES = 256;
+    BenchTrack deck_a("Render A", SAMPLES);
+    BenchTrack deck_b("Render B", SAMPLES);
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.loadTrackToDeck(deck_a);
+    mixer.loadTrackToDeck(deck_b);
+    mixer.setCrossfader(0.3f);
+    mixer.startRenderThread(FRAMES);
+
+    std::vector<float> out(FRAMES * MixingEngineService::OUTPUT_CHANNELS);
+    run_case("mixer/render_thread", "frames=" + std::to_string(FRAMES), [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            if (mixer.getDeckPosition(0) + 8 * FRAMES > SAMPLES) {
+                mixer.setDeckPosition(0, 0);
+                mixer.setDeckPosition(1, 0);
+            }
+            size_t done = 0;
+            while (done < FRAMES) {
+                done += mixer.readRenderedFrames(&out[done * MixingEngineService::OUTPUT_CHANNELS], FRAMES - done);
+            }
+        }
+    }, FRAMES);
+    mixer.stopRenderThread();
+}
+
+void bench_spsc_ring() {
+    SpscRing<uint64_t> items(256);
+    uint64_t item = 0;
+    run_case("mixer/spsc_ring", "items=1", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            items.push(i);
+            items.pop(item);
+        }
+    });
+
+    const size_t BLOCK = 512;
+    SpscRing<float> samples(4 * BLOCK);
+    std::vector<float> in(BLOCK, 0.5f), out(BLOCK);
+    run_case("mixer/spsc_ring", "items=" + std::to_string(BLOCK), [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            samples.push(in.data(), BLOCK);
+            samples.pop(out.data(), BLOCK);
+        }
+    }, BLOCK);
+}
+
+void bench_kernels() {
+    const size_t FRAMES = 1024;
+    std::vector<double> in0(FRAMES), in1(FRAMES);
+    for (size_t i = 0; i < FRAMES; ++i) {
+        in0[i] = WaveformBuffer::synthetic_sample(1, i);
+        in1[i] = WaveformBuffer::synthetic_sample(2, i);
+    }
+    std::vector<float> out(2 * FRAMES);
+
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel level : levels) {
+        const MixKernels* kernels = MixKernels::for_level(level);
+        if (!kernels) {
+            continue;
+        }
+        std::string simd = std::string(",simd=") + MixKernels::level_name(level);
+        run_case("mixer/kernel", "op=mix2" + simd, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                kernels->mix2_stereo(out.data(), in0.data(), 0.7f, in1.data(), 0.7f, FRAMES);
+            }
+        }, FRAMES);
+        run_case("mixer/kernel", "op=add" + simd, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                kernels->add_stereo(out.data(), in0.data(), 1e-3f, FRAMES);
+            }
+        }, FRAMES);
+        run_case("mixer/kernel", "op=clip" + simd, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                kernels->clip(out.data(), 2 * FRAMES, 1.0f);
+            }
+        }, FRAMES);
+    }
+}
+
+void bench_beat_tracking() {
+    const double SAMPLE_RATE = 44100.0;
+    const size_t SAMPLES = static_cast<size_t>(30 * SAMPLE_RATE);
+    WaveformBuffer waveform = WaveformBuffer::synthesized(SAMPLES, 5);
+    BeatTracker tracker(SAMPLE_RATE);
+
+    size_t before = results.size();
+    run_case("analysis/beat_track", "seconds=30", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            tracker.analyze(waveform);
+        }
+    }, SAMPLES);
+    if (results.size() > before) {
+        std::cout << "  -> " << std::setprecision(0) << 1e9 / SAMPLE_RATE / results.back().ns_per_op
+                  << "x realtime per core" << std::endl;
+    }
+
+    AnalysisCache cache;
+    cache.analyze(waveform, SAMPLE_RATE);
+    run_case("analysis/cache_hit", "seconds=30", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            cache.analyze(waveform, SAMPLE_RATE);
+        }
+    });
+}
+
+void bench_stretch() {
+    const size_t SAMPLES = 1 << 20;
+    const size_t BLOCK = 512;
+    const double SAMPLE_RATE = 44100.0;
+    std::vector<double> source(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        source[i] = WaveformBuffer::synthetic_sample(3, i);
+    }
+    std::vector<double> out(BLOCK);
+
+    const double ratios[] = {0.9, 0.97, 1.03, 1.5};
+    for (double ratio : ratios) {
+        std::ostringstream params;
+        params << "ratio=" << ratio;
+        TimeStretcher stretcher;
+        stretcher.set_ratio(ratio);
+        stretcher.reset(source.data(), source.size(), 0.0);
+        size_t before = results.size();
+        run_case("stretch/wsola", params.str(), [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                if (stretcher.process(out.data(), BLOCK) < BLOCK) {
+                    stretcher.reset(source.data(), source.size(), 0.0);
+                }
+            }
+        }, BLOCK);
+        if (results.size() > before) {
+            std::cout << "  -> " << std::setprecision(0) << 1e9 / SAMPLE_RATE / results.back().ns_per_op
+                      << "x realtime per core" << std::endl;
+        }
+    }
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void write_json(const std::string& path) {
+    std::ofstream out(path);
+    out << "{\n  \"suite\": \"dj_manager_micro\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", \"params\": {";
+        std::stringstream params(r.params);
+        std::string pair;
+        bool first = true;
+        while (std::getline(params, pair, ',')) {
+            size_t eq = pair.find('=');
+            std::string value = pair.substr(eq + 1);
+            bool numeric = !value.empty() && value.find_first_not_of("0123456789.-") == std::string::npos;
+            out << (first ? "" : ", ") << "\"" << json_escape(pair.substr(0, eq)) << "\": "
+                << (numeric ? value : "\"" + json_escape(value) + "\"");
+            first = false;
+        }
+        out << "}, \"ns_per_op\": " << std::fixed << std::setprecision(2) << r.ns_per_op
+            << ", \"allocs_per_op\": " << std::setprecision(4) << r.allocs_per_op
+            << ", \"ops\": " << r.ops << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string json_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 7, "--json=") == 0) json_path = arg.substr(7);
+        else if (arg.compare(0, 9, "--filter=") == 0) filter = arg.substr(9);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--json=path] [--filter=substring]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Keep track/playlist/mixer logging out of the measurements
+    Logger::set_quiet(true);
+
+    std::cout << std::left << std::setw(22) << "case" << std::setw(30) << "params" << std::right
+              << std::setw(14) << "ns/op" << std::setw(14) << "allocs/op" << std::endl;
+    bench_cache();
+    bench_clone();
+    bench_playlist();
+    bench_parser();
+    bench_mixer();
+    bench_transition();
+    bench_render();
+    bench_render_thread();
+    bench_spsc_ring();
+    bench_kernels();
+    bench_stretch();
+    bench_beat_tracking();
+    bench_bpm_index();
+    bench_search_index();
+
+    if (!json_path.empty()) {
+        write_json(json_path);
+        std::cout << "JSON results written to " << json_path << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include "PolicyLists.h"
+#include <vector>
+
+/**
+ * @brief Adaptive Replacement Cache (Megiddo & Modha)
+ *
+ * Resident entries live in T1 (seen once recently) or T2 (seen at least
+ * twice). Ghost lists B1/B2 remember keys evicted from T1/T2. A ghost hit
+ * shifts the target size p of T1, so the policy adapts between recency and
+ * frequency and a one-off scan cannot flush the frequently played tracks.
+ */
+class ARCPolicy : public EvictionPolicy {
+private:
+    size_t capacity;
+    size_t target_t1;              // ARC's adaptive parameter p
+    SlotList t1;
+    SlotList t2;
+    GhostList b1;
+    GhostList b2;
+    std::vector<uint64_t> keys;    // hashed key per slot
+    uint64_t adapted_key;          // key whose ghost hit already moved p
+    bool has_adapted;
+    bool drop_next_ghost;          // next T1 eviction skips B1
+
+    void adapt(uint64_t key);
+    size_t replace(uint64_t key) const;
+    void trimGhosts();
+
+public:
+    explicit ARCPolicy(size_t capacity);
+
+    const char* name() const override { return "ARC"; }
+    void onInsert(size_t slot, const std::string& key) override;
+    void onAccess(size_t slot) override;
+    void onRemove(size_t slot) override;
+    size_t selectVictim(const std::string& incoming) override;
+    void reset(size_t capacity) override;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BeatTracker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+class WaveformBuffer;
+
+/**
+ * @brief Content-addressed memo of beat-tracking results
+ *
+ * Entries are keyed by WaveformBuffer::content_hash() and the sample rate,
+ * not by track: every clone, and every track with the same samples, maps
+ * to one entry, so a waveform is analyzed at most once per process.
+ *
+ * Thread-safe. The map is locked only to find or insert an entry; the
+ * analysis runs under that entry's std::call_once, so concurrent callers
+ * for one waveform wait for a single analysis while other waveforms
+ * proceed in parallel. Entries are never removed, so returned references
+ * stay valid for the life of the cache.
+ */
+class AnalysisCache {
+public:
+    AnalysisCache();
+
+    AnalysisCache(const AnalysisCache&) = delete;
+    AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+    /**
+     * @brief The process-wide cache used by AudioTrack
+     */
+    static AnalysisCache& instance();
+
+    /**
+     * @brief Beat grid of a waveform, analyzing it on first request
+     * Rates BeatTracker cannot analyze return an undetected grid without
+     * hashing the samples or adding an entry.
+     */
+    const BeatGrid& analyze(const WaveformBuffer& waveform, double sample_rate);
+
+    /**
+     * @brief Number of distinct waveforms cached
+     */
+    size_t size() const;
+
+    /**
+     * @brief Number of analyses run so far (cache misses)
+     */
+    size_t analyses() const { return runs.load(std::memory_order_relaxed); }
+
+private:
+    struct Key {
+        uint64_t content;
+        double sample_rate;
+
+        bool operator==(const Key& other) const {
+            return content == other.content && sample_rate == other.sample_rate;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::once_flag analyzed;
+        BeatGrid grid;
+
+        Entry() : analyzed(), grid() {}
+    };
+
+    mutable std::mutex lock;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::atomic<size_t> runs;
+    const BeatGrid undetected;
+};
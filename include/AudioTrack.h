@@ -1,7 +1,10 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 #include "PointerWrapper.h"
+#include "WaveformBuffer.h"
+#include "BeatTracker.h"
 #include <memory>
 #include <vector>
 /**
@@ -12,19 +15,40 @@
  * - load(): lightweight, format-specific preparation when a track is assigned to a deck;
  *   sets readiness state and may log; does not start playback.
  * - analyze_beatgrid(): runs immediately after load() in this assignment to make BPM
- *   available for compatibility checks; results may be cached per instance.
+ *   available for compatibility checks; the beat grid is tracked from the waveform
+ *   once per process and shared by every track with the same samples (AnalysisCache).
  * - clone(): used at the cache→mixer boundary; mixer always receives a polymorphic clone
- *   and owns it; the cache retains its own copy.
+ *   and owns it. Library, playlist and cache share one instance through TrackHandle.
+ * - The waveform is a copy-on-write WaveformBuffer: clones share the samples and
+ *   only a clone that writes through get_mutable_waveform() gets a private copy.
+ * - The waveform is generated lazily on first access, deterministically from the
+ *   track identity (title, artists, duration, bpm).
+ * - The library analysis pass (LibraryAnalyzer) attaches a TrackAnalysis to each
+ *   library track before the session starts; clones share it.
  * 
  */
+
+/**
+ * Per-track results of the library analysis pass
+ * Attached once, before the live loop starts, and immutable afterwards.
+ */
+struct TrackAnalysis {
+    const BeatGrid* beatgrid;   // AnalysisCache entry
+    float quality;              // get_quality_score()
+    float peak;                 // largest absolute sample
+    float rms;                  // root mean square of the samples
+
+    TrackAnalysis() : beatgrid(nullptr), quality(0.0f), peak(0.0f), rms(0.0f) {}
+};
+
 class AudioTrack {
 protected:
     std::string title;
     std::vector<std::string> artists;
     int duration_seconds;
     int bpm;  // beats per minute for mixing
-    double* waveform_data;  // Dynamic array for audio analysis
-    size_t waveform_size;   // Size of the waveform array
+    WaveformBuffer waveform;  // Shared copy-on-write samples for audio analysis
+    std::shared_ptr<const TrackAnalysis> analysis;  // Library analysis pass result; null until it ran
 
 public:
     /**
@@ -38,19 +62,19 @@ public:
 
     /**
      * TODO: Implement destructor
-     * HINT: Don't forget to clean up waveform_data!
+     * HINT: The waveform buffer releases its reference on its own
      */
     virtual ~AudioTrack();
 
     /**
      * TODO: Implement copy constructor
-     * HINT: Deep copy the waveform_data array
+     * HINT: The waveform samples are shared, not copied (copy-on-write)
      */
     AudioTrack(const AudioTrack& other);
 
     /**
      * TODO: Implement copy assignment operator
-     * HINT: Check for self-assignment, clean up existing data, then deep copy
+     * HINT: Check for self-assignment, then share the other track's waveform
      */
     AudioTrack& operator=(const AudioTrack& other);
 
@@ -101,13 +125,77 @@ public:
      * Function to get a copy of the waveform data
      */
     void get_waveform_copy(double* buffer, size_t buffer_size) const;
+
+    /**
+     * Read-only view of the waveform samples (shared between clones)
+     */
+    const double* get_waveform_data() const { return waveform.data(); }
+    size_t get_waveform_size() const { return waveform.size(); }
+
+    /**
+     * Shared waveform buffer, for chunked reads (WaveformBuffer::read) that
+     * leave lazy samples unmaterialized
+     */
+    const WaveformBuffer& get_waveform() const { return waveform; }
+
+    /**
+     * Writable waveform samples; detaches this track's copy if it is shared
+     * and drops the stored analysis, which no longer describes the samples
+     */
+    double* get_mutable_waveform() {
+        analysis.reset();
+        return waveform.mutable_data();
+    }
+
+    /**
+     * Beat grid tracked from the waveform; analyzed on first request, then
+     * served from the process-wide AnalysisCache. Does not materialize lazy samples.
+     * The sample rate is the waveform size over the duration. Library
+     * waveforms (1000 samples per track) are far below a rate BeatTracker
+     * can resolve, so their grid is undetected rather than guessed.
+     * Tracks with a stored analysis return its grid without a cache lookup.
+     */
+    const BeatGrid& get_beatgrid() const;
+
+    /**
+     * One-line report of get_beatgrid() for analyze_beatgrid()'s Debug
+     * lines: tempo, beats and confidence, or why there is no grid
+     */
+    std::string describe_beatgrid() const;
+
+    /**
+     * Results of the library analysis pass; nullptr if it has not run.
+     * Shared with clones, so storing it costs a pointer per track.
+     */
+    const TrackAnalysis* get_analysis() const { return analysis.get(); }
+    void set_analysis(const TrackAnalysis& result) { analysis = std::make_shared<const TrackAnalysis>(result); }
+
+    /**
+     * Approximate memory owned by this track in bytes: the object itself,
+     * title and artist strings, and the waveform array.
+     * Used by byte-budgeted caches.
+     */
+    size_t get_memory_footprint() const;
     
     // ========== ACCESSOR FUNCTIONS ==========
-    std::string get_title() const { return title; }
+    const std::string& get_title() const { return title; }
     int get_bpm() const { return bpm; }
     int get_duration() const { return duration_seconds; }
     std::vector<std::string> get_artists() const { return artists; }
 
     // ========== Helper Functions ===========
     void set_bpm(int new_bpm);
-};
\ No newline at end of file
+
+    /**
+     * Seed for the synthetic waveform, derived from the track identity
+     */
+    static uint64_t waveform_seed(const std::string& title, const std::vector<std::string>& artists,
+                                  int duration, int bpm);
+};
+
+/**
+ * Shared, reference-counted handle to a library-owned track.
+ * Playlists and the controller cache hold handles to the canonical library
+ * entries instead of cloning them; the mixer deck still takes a private clone.
+ */
+typedef std::shared_ptr<AudioTrack> TrackHandle;
\ No newline at end of file
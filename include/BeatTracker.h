@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class WaveformBuffer;
+
+/**
+ * @brief Result of beat tracking: a constant-tempo grid
+ * Beat k is at first_beat + k * 60 / bpm seconds, for k < beats.
+ */
+struct BeatGrid {
+    double bpm;          // 0 when no tempo was found
+    double first_beat;   // seconds from the start of the track
+    double confidence;   // autocorrelation strength of the tempo, in [0, 1]
+    size_t beats;        // beats from first_beat to the end of the track
+
+    BeatGrid() : bpm(0.0), first_beat(0.0), confidence(0.0), beats(0) {}
+
+    bool detected() const { return bpm > 0.0; }
+    double beat_time(size_t k) const { return first_beat + k * 60.0 / bpm; }
+};
+
+/**
+ * @brief Onset-based beat tracker over mono waveform samples
+ *
+ * Three stages:
+ * - Onset envelope: spectral flux between Hann-windowed FFT frames (about
+ *   20 ms long, half overlapped) of log-compressed magnitudes, with the
+ *   local mean removed and negative values dropped.
+ * - Tempo: autocorrelation of the envelope over lags between MAX_BPM and
+ *   MIN_BPM, weighted by a log-normal prior around PRIOR_BPM to avoid
+ *   octave errors, refined to a fractional lag by a parabola through the peak.
+ * - Phase: the offset whose comb of beats at that period collects the most
+ *   onset energy. Period and phase are then refined by a weighted
+ *   least-squares line through the onset peaks found near each beat.
+ *
+ * Samples are read through WaveformBuffer::read() one frame at a time, so
+ * analyzing a lazy waveform does not materialize it. Sample rates too low
+ * to resolve an onset frame give an undetected grid.
+ */
+class BeatTracker {
+public:
+    static constexpr double MIN_BPM = 60.0;
+    static constexpr double MAX_BPM = 200.0;
+    static constexpr double PRIOR_BPM = 120.0;
+    static const size_t MIN_FRAME = 16;   // smallest usable onset frame, in samples
+
+    explicit BeatTracker(double sample_rate);
+
+    /**
+     * @brief Whether sample_rate is high enough for onset frames of MIN_FRAME samples
+     */
+    static bool can_analyze(double sample_rate);
+
+    /**
+     * @brief Track the beats of a whole waveform
+     */
+    BeatGrid analyze(const WaveformBuffer& waveform);
+
+    /**
+     * @brief Onset envelope of the last analyze(), one value per hop
+     */
+    const std::vector<double>& envelope() const { return onsets; }
+
+    size_t frame_size() const { return frame; }
+    size_t hop_size() const { return hop; }
+
+private:
+    double sample_rate;
+    size_t frame;
+    size_t hop;
+    std::vector<double> window;
+    std::vector<double> twiddle_re;  // e^(-2 pi i k / frame), k < frame / 2
+    std::vector<double> twiddle_im;
+    std::vector<double> input;       // one frame of samples
+    std::vector<double> real;        // half-size complex FFT of the frame
+    std::vector<double> imag;
+    std::vector<double> magnitude;   // log magnitudes of the previous frame
+    std::vector<double> onsets;
+
+    void onset_envelope(const WaveformBuffer& waveform);
+    /**
+     * @brief In-place complex FFT of the frame / 2 points in real/imag
+     */
+    void fft();
+
+    /**
+     * @brief Beat period in envelope frames (fractional), 0 if none; sets confidence
+     */
+    double estimate_period(double& confidence) const;
+
+    /**
+     * @brief Envelope frame of the first beat for a period
+     */
+    double estimate_phase(double period) const;
+
+    /**
+     * @brief Least-squares fit of period and phase to the onset peaks near each beat
+     */
+    void fit_grid(double& period, double& phase) const;
+};
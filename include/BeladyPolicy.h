@@ -0,0 +1,46 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include "PlaybackSchedule.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Belady's optimal (OPT) replacement over a known play order
+ *
+ * Evicts the resident entry whose next use in the PlaybackSchedule is
+ * furthest away (entries never played again go first). The schedule is not
+ * owned; its owner (DJControllerService) advances it as tracks are played.
+ * Victim selection scans the resident entries, O(capacity log n) per eviction.
+ */
+class BeladyPolicy : public EvictionPolicy {
+private:
+    const PlaybackSchedule* schedule;
+    std::vector<uint64_t> keys;          // hashed key per slot
+    std::vector<size_t> resident;        // occupied slots
+    std::vector<size_t> resident_pos;    // slot -> index in resident
+
+public:
+    explicit BeladyPolicy(const PlaybackSchedule* schedule, size_t capacity = 0);
+
+    // copy constructor and assignment deleted: the schedule is shared, not owned
+    BeladyPolicy(const BeladyPolicy&) = delete;
+    BeladyPolicy& operator=(const BeladyPolicy&) = delete;
+
+    const char* name() const override { return "Belady"; }
+    void onInsert(size_t slot, const std::string& key) override;
+    void onAccess(size_t slot) override;
+    void onRemove(size_t slot) override;
+    size_t selectVictim(const std::string& incoming) override;
+    void reset(size_t capacity) override;
+
+    /**
+     * @brief Resident slots as (next use, slot), furthest next use first
+     * This is the order successive selectVictim() calls evict them in; only
+     * entries never played again (NEVER) tie, and those go first in any order.
+     */
+    std::vector<std::pair<size_t, size_t> > evictionOrder() const;
+
+private:
+    size_t furthestSlot() const;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Track formats distinguished by the library indexes
+ */
+enum class TrackKind : uint8_t { MP3 = 0, WAV = 1, Any = 2 };
+
+/**
+ * @brief Bucketed BPM index over the library for compatible-track queries
+ *
+ * One bucket per integer BPM in [MIN_BPM, MAX_BPM], kept separately for
+ * each track kind. Within a bucket, tracks are ordered by quality score
+ * (highest first, ties by library index), so a minimum-quality filter is
+ * a prefix of every bucket. Queries touch only the buckets in range and
+ * the results they return: O(buckets + results), no allocation beyond
+ * the caller's output vector.
+ *
+ * Tracks whose BPM is outside [MIN_BPM, MAX_BPM] are not indexed.
+ * Results are library indices (0-based positions in the library vector).
+ */
+class BpmIndex {
+public:
+    static const int MIN_BPM = 0;
+    static const int MAX_BPM = 999;
+
+    struct Entry {
+        uint32_t library_index;
+        int bpm;
+        float quality;
+        TrackKind kind;          // MP3 or WAV
+    };
+
+    /**
+     * @brief Query restriction: track kind and minimum quality score
+     */
+    struct Filter {
+        TrackKind kind;
+        double min_quality;
+
+        Filter(TrackKind kind = TrackKind::Any, double min_quality = 0.0)
+            : kind(kind), min_quality(min_quality) {}
+    };
+
+    BpmIndex();
+
+    /**
+     * @brief Replace the index contents with entries
+     */
+    void build(const std::vector<Entry>& entries);
+
+    void clear();
+
+    size_t size() const { return indexed; }
+    size_t unindexed() const { return skipped; }
+
+    /**
+     * @brief Number of indexed tracks with min_bpm <= BPM <= max_bpm, any kind or quality
+     */
+    size_t count(int min_bpm, int max_bpm) const;
+
+    /**
+     * @brief Append up to limit tracks with min_bpm <= BPM <= max_bpm
+     * Ordered by BPM ascending, then quality descending.
+     * @return Number of indices appended
+     */
+    size_t find_range(int min_bpm, int max_bpm, const Filter& filter, size_t limit,
+                      std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Append the k tracks closest in BPM to bpm, at most max_distance away
+     * Ordered by distance; at equal distance the slower BPM comes first, then
+     * quality descending.
+     * @return Number of indices appended
+     */
+    size_t find_nearest(int bpm, size_t k, int max_distance, const Filter& filter,
+                        std::vector<uint32_t>& out) const;
+
+private:
+    static const size_t BUCKETS = MAX_BPM - MIN_BPM + 1;
+    static const size_t KINDS = 2;
+
+    // Per kind: bucket b spans [start[b], start[b + 1]) of quality and ids
+    struct KindBuckets {
+        std::vector<uint32_t> start;
+        std::vector<float> quality;
+        std::vector<uint32_t> ids;
+
+        KindBuckets() : start(BUCKETS + 1, 0), quality(), ids() {}
+    };
+
+    KindBuckets kinds[KINDS];
+    size_t indexed;
+    size_t skipped;
+
+    /**
+     * @brief Append up to limit filtered tracks of one bucket, merging kinds by quality
+     */
+    size_t take_bucket(size_t bucket, const Filter& filter, size_t limit, std::vector<uint32_t>& out) const;
+};
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "AudioTrack.h"
-#include "PointerWrapper.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -13,17 +12,27 @@
  * following SRP and making the design easier to test and maintain.
  *
  * Phase 4 usage:
- * - Each slot holds exactly one cached track instance owned by the controller.
+ * - Each slot holds a shared handle to one cached track (usually a library entry).
  * - access() updates last_access_time to reflect MRU/LRU policy.
  * - clear() releases ownership; callers log evictions as needed.
+ * - prev/next thread the slot into LRUCache's intrusive recency list
+ *   (slot indices, NO_SLOT terminates the list).
  */
 class CacheSlot {
 private:
-    PointerWrapper<AudioTrack> track;    // The cached track
+    TrackHandle track;                   // The cached track (shared)
     uint64_t last_access_time;           // For LRU algorithm
+    size_t bytes;                        // Memory footprint of the cached track
     bool occupied;                       // Is this slot in use?
+    size_t prev;                         // Next more recently used slot
+    size_t next;                         // Next less recently used slot
 
 public:
+    /**
+     * @brief Sentinel link value meaning "no slot"
+     */
+    static const size_t NO_SLOT = static_cast<size_t>(-1);
+
     /**
      * @brief Construct empty cache slot
      */
@@ -31,10 +40,10 @@ public:
     
     /**
      * @brief Store a track in this slot
-     * @param track_ptr Track to store (transfers ownership)
+     * @param track_ptr Handle to the track to store (shared, not copied)
      * @param access_time Current access timestamp
      */
-    void store(PointerWrapper<AudioTrack> track_ptr, uint64_t access_time);
+    void store(const TrackHandle& track_ptr, uint64_t access_time);
     
     /**
      * @brief Access the track (updates LRU timestamp)
@@ -44,7 +53,7 @@ public:
     AudioTrack* access(uint64_t access_time);
     
     /**
-     * @brief Clear this slot (removes track)
+     * @brief Clear this slot (drops the track handle)
      */
     void clear();
     
@@ -57,9 +66,25 @@ public:
      * @brief Get last access time for LRU comparison
      */
     uint64_t getLastAccessTime() const { return last_access_time; }
+
+    /**
+     * @brief Get memory footprint of the stored track (0 when empty)
+     */
+    size_t getBytes() const { return bytes; }
     
     /**
      * @brief Get track without updating access time
      */
     AudioTrack* getTrack() const { return track.get(); }
+
+    /**
+     * @brief Get the shared handle to the stored track
+     */
+    const TrackHandle& getHandle() const { return track; }
+
+    // ========== INTRUSIVE RECENCY LINKS ==========
+    size_t getPrev() const { return prev; }
+    size_t getNext() const { return next; }
+    void setPrev(size_t slot) { prev = slot; }
+    void setNext(size_t slot) { next = slot; }
 };
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "LRUCache.h"
+#include "EvictionPolicy.h"
+#include "PointerWrapper.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Thread-safe sharded LRU cache
+ *
+ * Keys are hashed by title to one of N shards. Each shard is an independent
+ * LRUCache guarded by its own mutex and with its own access counter, so
+ * threads touching different shards never contend. Capacity and byte budget
+ * are split evenly across shards; eviction is per shard (approximate global
+ * LRU). With a single shard the behavior and output match LRUCache exactly.
+ * There are never more shards than slots: a request for more is clamped to
+ * the capacity (with a warning), so no shard is left with zero slots.
+ *
+ * Same get/put/evictLRU/contains contract as LRUCache. Pointers returned by
+ * get() stay valid until another put() evicts that entry; callers sharing
+ * the cache between threads must not hold them across such puts.
+ */
+class ConcurrentLRUCache {
+private:
+    struct Shard {
+        mutable std::mutex lock;
+        LRUCache cache;
+        std::vector<const std::string*> pending;   // titles get_or_insert() is preparing (owned by the callers' tracks)
+        std::condition_variable prepared;          // signalled when a pending title is settled
+        size_t waiting;                            // threads blocked on prepared
+
+        explicit Shard(size_t capacity) : lock(), cache(capacity), pending(), prepared(), waiting(0) {}
+
+        bool isPending(const std::string& title) const;
+        void settle(const std::string& title);
+    };
+
+    std::vector<PointerWrapper<Shard> > shards;
+    size_t max_size;
+    size_t max_bytes;
+    size_t requested_shards;   // set_shard_count() argument, before clamping to the capacity
+
+    /**
+     * @brief Capacity of one shard when total is split over count shards
+     */
+    static size_t shareOf(size_t total, size_t shard, size_t count);
+
+    /**
+     * @brief requested_shards clamped to the capacity
+     */
+    size_t usableShards() const;
+
+    /**
+     * @brief Re-create count empty shards over the current capacity and byte budget
+     * Warns when count is below requested_shards.
+     */
+    void reshard(size_t count);
+
+public:
+    /**
+     * @brief Outcome of get_or_insert()
+     */
+    enum class Lookup { Hit, Inserted, InsertedWithEviction, TooLarge };
+
+    /**
+     * @brief Construct a sharded cache
+     * @param capacity Total number of tracks to cache (split across shards)
+     * @param shard_count Number of independently locked shards (at least 1)
+     */
+    explicit ConcurrentLRUCache(size_t capacity, size_t shard_count = 1);
+
+    // copy constructor and assignment deleted: shards own mutexes and tracks
+    ConcurrentLRUCache(const ConcurrentLRUCache&) = delete;
+    ConcurrentLRUCache& operator=(const ConcurrentLRUCache&) = delete;
+
+    bool contains(const std::string& track_id) const;
+    AudioTrack* get(const std::string& track_id);
+
+    /**
+     * @brief Put a track into its shard (handles eviction if that shard is full)
+     * @return true if an eviction occurred, false otherwise.
+     */
+    bool put(const TrackHandle& track);
+    bool put(PointerWrapper<AudioTrack> track);
+
+    /**
+     * @brief Touch a cached track, or prepare and insert it
+     * @param prepare Called on a miss before the track is published (e.g. load and analyze)
+     * prepare runs without the shard lock, so other titles on the shard stay
+     * available meanwhile. The title is marked pending while it runs: threads
+     * missing on the same title wait for it and then see a Hit, so each title
+     * is prepared and inserted once. A track larger than its shard's byte
+     * budget is neither prepared nor inserted (TooLarge).
+     */
+    Lookup get_or_insert(const TrackHandle& track, const std::function<void(AudioTrack&)>& prepare);
+
+    /**
+     * @brief Check whether a track fits the byte budget of its shard at all
+     */
+    bool canFit(const std::string& track_id, size_t bytes) const;
+
+    /**
+     * @brief Evict one entry from the fullest shard
+     * @return true if a track was evicted
+     */
+    bool evictLRU();
+
+    size_t size() const;
+    size_t capacity() const { return max_size; }
+
+    /**
+     * @brief Check if every shard is full
+     */
+    bool isFull() const;
+
+    void clear();
+    void displayStatus() const;
+
+    /**
+     * @brief Update total capacity (split across shards)
+     * If the capacity changes how many shards are usable (see
+     * set_shard_count()), the shards are re-created and all entries dropped.
+     */
+    void set_capacity(size_t capacity);
+
+    /**
+     * @brief Set total byte budget (split across shards), 0 disables it
+     */
+    void set_byte_budget(size_t bytes);
+
+    /**
+     * @brief Re-create the cache with a new number of shards (drops all entries)
+     * At most one shard per slot is used; a larger count is clamped to the
+     * capacity with a warning and applied in full if the capacity grows.
+     */
+    void set_shard_count(size_t shard_count);
+
+    size_t shardCount() const { return shards.size(); }
+
+    /**
+     * @brief Shard that a title hashes to
+     */
+    size_t shardOf(const std::string& track_id) const;
+
+    size_t shardCapacity(size_t shard) const;
+    bool shardIsFull(size_t shard) const;
+
+    /**
+     * @brief Run a read-only check on one shard's cache under its lock
+     */
+    void inspectShard(size_t shard, const std::function<void(const LRUCache&)>& inspect) const;
+
+    /**
+     * @brief Install a replacement policy on one shard (transfers ownership)
+     */
+    void set_policy(size_t shard, PointerWrapper<EvictionPolicy> policy);
+
+    const char* policyName() const;
+};
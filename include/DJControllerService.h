@@ -1,25 +1,42 @@
 #ifndef DJCONTROLLERSERVICE_H
 #define DJCONTROLLERSERVICE_H
 
-#include "LRUCache.h"
+#include "ConcurrentLRUCache.h"
 #include "CacheSlot.h"
+#include "BeladyPolicy.h"
+#include "PlaybackSchedule.h"
 #include "PointerWrapper.h"
 #include <string>
+#include <vector>
 
 /**
  * Service responsible for managing the controller's memory (cache)
- * Cache capacity is fixed, and the tracks are managed with LRU policy.
+ * Cache capacity is fixed, and the tracks are managed with LRU policy by default
+ * (ARC, 2Q or W-TinyLFU can be selected instead).
  * On HIT: touch MRU (most recently used); on MISS: insert; if full, evict LRU.
  * - Mixer always receives a polymorphic clone; cache retains its copy.
+ * Lookahead mode: given the upcoming play order, the controller prefetches
+ * the next K titles and evicts the entry whose next use is furthest away
+ * (Belady/OPT) instead of the LRU one.
+ * The cache is a ConcurrentLRUCache; with the default single shard it
+ * behaves exactly like LRUCache, more shards allow concurrent sessions.
  */
 class DJControllerService {
 public:
     // Construct with a given cache size
     explicit DJControllerService(size_t cache_size = 8);
 
+    // copy constructor and assignment deleted: the cache and policies are not copyable
+    DJControllerService(const DJControllerService&) = delete;
+    DJControllerService& operator=(const DJControllerService&) = delete;
+
     // Contract: Ensure a track is present in cache by key (full playlist line)
-    // Input: A reference to an AudioTrack.
-    // Output: An integer indicating the result: 1 for HIT, 0 for MISS without eviction, -1 for MISS with eviction.
+    // Input: A shared handle to a library track; the cache shares it, nothing is cloned.
+    // Output: An integer indicating the result: 1 for HIT, 0 for MISS without eviction, -1 for MISS with eviction,
+    //         -2 if the track is larger than the cache's byte budget (it is neither loaded nor cached).
+    int loadTrackToCache(const TrackHandle& track);
+
+    // Same contract for a track without a handle: the cache stores a private clone.
     int loadTrackToCache(AudioTrack& track);
 
 
@@ -33,6 +50,40 @@ public:
      * @note This function is meant for a single usage. don't call it more then once.
      */
     void set_cache_size(size_t new_size);
+
+    /**
+     * @brief Limit the cache by the memory footprint of its tracks.
+     * @param bytes Byte budget, 0 disables the limit (slot count still applies).
+     */
+    void set_cache_byte_budget(size_t bytes);
+
+    /**
+     * @brief Split the cache into independently locked shards.
+     * @param shards Number of shards (1 = plain LRU cache behavior); clamped
+     * to the cache size, with a warning, so every shard has a slot.
+     * @note Drops cached tracks and resets the policy to LRU; call after
+     * set_cache_size() and before set_cache_policy() / set_lookahead().
+     */
+    void set_cache_shards(size_t shards);
+
+    /**
+     * @brief Select the cache eviction policy by name.
+     * @param policy_name "lru", "arc", "2q" or "tinylfu" (case-insensitive).
+     * @return false (and keeps the current policy) if the name is unknown.
+     */
+    bool set_cache_policy(const std::string& policy_name);
+
+    /**
+     * @brief Name of the active cache eviction policy (e.g. "LRU")
+     */
+    const char* getCachePolicyName() const;
+
+    /**
+     * @brief Check whether a track fits the cache's byte budget at all
+     * Tracks that do not are never cached; play them from the library instead.
+     */
+    bool isCacheable(const AudioTrack& track) const;
+
     /**
      * @brief Get a track from the cache by its title.
      * @param track_title The title of the track to retrieve.
@@ -40,8 +91,41 @@ public:
      */
     AudioTrack* getTrackFromCache(const std::string& track_title);
 
+    // ========== LOOKAHEAD (BELADY) MODE ==========
+
+    /**
+     * @brief Enable lookahead mode: prefetch window of K titles and Belady eviction.
+     * @param tracks Prefetch window K; 0 disables lookahead and restores LRU.
+     * @note Overrides any policy chosen with set_cache_policy().
+     */
+    void set_lookahead(size_t tracks);
+
+    size_t get_lookahead() const { return lookahead; }
+
+    /**
+     * @brief Provide the upcoming play order (positions are indices into titles).
+     */
+    void set_upcoming_tracks(const std::vector<std::string>& titles);
+
+    /**
+     * @brief Mark the position in the play order that is being played now.
+     */
+    void advance_to(size_t position);
+
+    /**
+     * @brief Prefetch a track that will be played at use_position.
+     * @return true if the track was loaded into the cache.
+     * Skipped when the track is cached already, or when making room (for
+     * slots or for the byte budget) would evict an entry that is needed
+     * sooner than use_position.
+     */
+    bool prefetchTrack(const TrackHandle& track, size_t use_position);
+
 private:
-    LRUCache cache;
+    ConcurrentLRUCache cache;
+    PlaybackSchedule schedule;
+    std::vector<BeladyPolicy*> belady;    // one per shard; non-owning, the cache owns them
+    size_t lookahead;
 };
 
 #endif // DJCONTROLLERSERVICE_H
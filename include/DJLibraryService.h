@@ -4,6 +4,8 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
 #include "SessionFileParser.h"
+#include "BpmIndex.h"
+#include "TrackSearchIndex.h"
 #include <vector>
 #include <string>
 
@@ -11,10 +13,11 @@
 // Phase 4 behavior alignment:
 // - Load library tracks from config file
 // - Build playlists from track indices referencing the library
+//   (playlists share the library's tracks through TrackHandle)
 class DJLibraryService {
 public:
     DJLibraryService(const Playlist& playlist);
-    DJLibraryService(): playlist(), library(){}
+    DJLibraryService(): playlist(), library(), bpm_index(), search_index(), search_indexing(true){}
 
     /**
      * @brief Build the track library from parsed config data
@@ -22,6 +25,26 @@ public:
      */
     void buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks);
 
+    /**
+     * @brief Build the track library from a loaded snapshot, copying each string once
+     */
+    void buildLibrary(const SnapshotTrackTable& tracks);
+
+    /**
+     * @brief Build the track library from whichever form the config holds
+     */
+    void buildLibrary(const SessionConfig& config);
+
+    /**
+     * @brief Precompute quality, beat grid and loudness for every library track
+     * Runs the LibraryAnalyzer pass after buildLibrary and stores the results
+     * with the tracks, so later loads and BPM index builds reuse them. The BPM
+     * index is rebuilt with the analyzed quality scores.
+     * @param threads Number of workers; 0 means one per hardware thread
+     * @return Number of tracks with a detected beat grid
+     */
+    size_t analyzeLibrary(size_t threads = 0);
+
     /**
      * @brief Load a playlist by constructing it from track indices
      * @param playlist_name Name of the playlist
@@ -43,15 +66,87 @@ public:
      */
     AudioTrack* findTrack(const std::string& track_title);
 
+    /**
+     * @brief Find a track in the current playlist and share it.
+     * @return A handle to the library's track, or an empty handle if not found.
+     */
+    TrackHandle findTrackHandle(const std::string& track_title) const;
+
     /**
      * @brief Get a vector of all track titles in the current playlist.
      * @return A vector of strings containing the track titles.
      */
     std::vector<std::string> getTrackTitles() const;
 
+    /**
+     * @brief BPM index over the whole library, rebuilt by buildLibrary and analyzeLibrary
+     */
+    const BpmIndex& getBpmIndex() const { return bpm_index; }
+
+    /**
+     * @brief Library tracks within tolerance BPM of bpm, closest BPM first
+     * Suggests what can follow a deck playing at bpm.
+     * @param filter Optional track kind and minimum quality score
+     * @param limit Maximum number of tracks returned
+     */
+    std::vector<TrackHandle> findCompatibleTracks(int bpm, int tolerance,
+                                                  const BpmIndex::Filter& filter = BpmIndex::Filter(),
+                                                  size_t limit = 10) const;
+
+    /**
+     * @brief Index titles and artists for search (on by default)
+     * While on, buildLibrary indexes each track as it adds it; turning it on
+     * again indexes the tracks already in the library. Sessions that never
+     * search may turn it off before buildLibrary to skip the cost. Turning
+     * it off drops the index; searching while off is an error.
+     */
+    void setSearchIndexing(bool enabled);
+    bool isSearchIndexing() const { return search_indexing; }
+
+    /**
+     * @brief Library tracks whose title and/or artists match query
+     * Case-insensitive; the last word matches as a prefix (autocomplete).
+     * Logs an error and returns nothing if search indexing is off.
+     */
+    std::vector<TrackHandle> searchTracks(const std::string& query, size_t limit = 20,
+                                          SearchField field = SearchField::Any) const;
+
+    /**
+     * @brief Library tracks credited to all of the given artists
+     */
+    std::vector<TrackHandle> findTracksByArtists(const std::vector<std::string>& artists,
+                                                 size_t limit = 20) const;
+
+    /**
+     * @brief Completions for a partially typed title or artist word
+     */
+    std::vector<std::string> completeSearch(const std::string& prefix, size_t limit = 10) const;
+
+    /**
+     * @brief The library track at a 0-based index (as returned by the indexes)
+     */
+    TrackHandle getLibraryTrack(size_t index) const;
+
 private:
     Playlist playlist;
-    std::vector<AudioTrack*> library;  // Library of all tracks (owned)
+    std::vector<TrackHandle> library;  // Library of all tracks (canonical instances)
+    BpmIndex bpm_index;                // BPM buckets over library, for compatible-track queries
+    TrackSearchIndex search_index;     // title/artist tokens over library, while search_indexing
+    bool search_indexing;
+
+    void rebuildBpmIndex();
+
+    /**
+     * @brief Create a library track (WAV or MP3) and append it to the library
+     */
+    void addTrack(bool wav, const std::string& title, const std::vector<std::string>& artists,
+                  int duration_seconds, int bpm, int extra_param1, int extra_param2);
+    /**
+     * @brief Log an error and return false if search indexing is off
+     */
+    bool checkSearchIndexing(const char* operation) const;
+
+    std::vector<TrackHandle> toHandles(const std::vector<uint32_t>& indices) const;
 };
 
 #endif // DJLIBRARYSERVICE_H
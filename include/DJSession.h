@@ -39,7 +39,13 @@ private:
     ConfigurationManager config_manager;
     SessionConfig session_config;
     std::vector<std::string> track_titles;
+    std::string config_path;
+    std::string snapshot_path;       // empty = always parse the text config
     bool play_all;
+    bool analyze_library;            // run the library analysis pass after buildLibrary
+    bool live_render;                // render on the mixer's render thread and play it back
+    std::string stats_path;          // empty = no machine-readable stats dump
+    MixingEngineService::RenderTelemetry render_report;   // telemetry of the last summary, reused by the dump
     // Session statistics
     struct SessionStats {
         size_t tracks_processed = 0;
@@ -50,6 +56,7 @@ private:
         size_t deck_loads_b = 0;
         size_t transitions = 0;
         size_t errors = 0;
+        size_t prefetches = 0;
     } stats;
 
 public:
@@ -58,8 +65,10 @@ public:
     /**
      * @brief Construct a new DJSession orchestrator
      * @param name Session identifier
+     * @param config_path Session configuration file
      */
-    DJSession(const std::string& name = "DJ Session", bool play_all = false);
+    DJSession(const std::string& name = "DJ Session", bool play_all = false,
+              const std::string& config_path = "bin/dj_config.txt");
 
     /**
      * @brief Destructor
@@ -79,7 +88,8 @@ public:
     /**
      * Contract: Demand-load a track into the controller cache.
      * - Input: The name of the track to load.
-     * - Output: An integer indicating a HIT (1) or MISS (0).
+     * - Output: An integer indicating a HIT (1) or MISS (0), a MISS with eviction (-1),
+     *   or -2 if the track exceeds the cache byte budget (counted as an error).
      */
     int load_track_to_controller(const std::string& track_name);
 
@@ -87,6 +97,7 @@ public:
      * Contract: Load a cached track into a mixer deck (instant-transition model)
      * - Input: track title (or key).
      * - Output: true on success; false if not found in cache or clone fails
+     * - Tracks larger than the cache byte budget are loaded from the library instead
      */
     bool load_track_to_mixer_deck(const std::string& track_title);
 
@@ -95,6 +106,43 @@ public:
      */
     void simulate_dj_performance();
 
+    /**
+     * Contract: Non-interactive scale test
+     * - Replays every playlist (in name order) with logging in quiet mode
+     * - Reports wall time, peak RSS and time spent per stage
+     *   (parse, buildLibrary, library analysis when enabled,
+     *   loadPlaylistFromIndices, controller, mixer)
+     * - Output: false if the configuration cannot be loaded
+     */
+    bool run_scale_test();
+
+    /**
+     * @brief Load the configuration from a binary snapshot when it is current
+     * A missing or stale snapshot is rebuilt after parsing the text config.
+     * Empty (the default) disables snapshots.
+     */
+    void set_snapshot_path(const std::string& path) { snapshot_path = path; }
+
+    /**
+     * @brief Analyze the whole library (LibraryAnalyzer) right after building it
+     * Off by default; the scale test then reports it as its own stage.
+     */
+    void set_library_analysis(bool enabled) { analyze_library = enabled; }
+
+    /**
+     * @brief Render the mix on the mixer's render thread during the interactive session
+     * After each deck load, a simulated output device plays a few blocks in
+     * real time. The summary then adds render time percentiles, deadline
+     * misses (xruns) and output underruns. Off by default.
+     */
+    void set_live_render(bool enabled) { live_render = enabled; }
+
+    /**
+     * @brief Also write the session summary and render telemetry as JSON to path
+     * Written once at the end of the session (or of the scale test).
+     */
+    void set_stats_path(const std::string& path) { stats_path = path; }
+
 
     // ========== STATUS & DISPLAY METHODS ==========
 
@@ -106,7 +154,7 @@ private:
     // ========== PROVIDED HELPER METHODS (Menu and Config) ==========
     
     /**
-     * @brief Load configuration from bin/dj_config.txt
+     * @brief Load configuration from config_path (bin/dj_config.txt by default)
      * @return true if configuration loaded successfully
      */
     bool load_configuration();
@@ -116,8 +164,28 @@ private:
      * @return Selected playlist name, or empty string if cancelled
      */
     std::string display_playlist_menu_from_config();
+    /**
+     * @brief Prefetch the titles following a play position (lookahead mode only)
+     * @param position Index into track_titles of the track being played
+     */
+    void prefetch_upcoming(size_t position);
+
+    /**
+     * @brief Play blocks of rendered output in real time, like an audio device
+     * One block is read per block period; a short read is an underrun.
+     */
+    void play_rendered(size_t blocks);
+
     /**
      * @brief Print final session summary with statistics
+     * Takes one render telemetry snapshot into render_report and prints from it.
+     */
+    void print_session_summary();
+
+    /**
+     * @brief Write the summary statistics and render_report as JSON to stats_path
+     * Called once at the end of a session, so the dump matches the last summary.
+     * @return false if the file cannot be written
      */
-    void print_session_summary() const;
+    bool write_stats_dump() const;
 };
\ No newline at end of file
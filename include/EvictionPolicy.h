@@ -0,0 +1,67 @@
+#pragma once
+
+#include "PointerWrapper.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Replacement Policy Interface for LRUCache
+ *
+ * LRUCache owns the slots and the title index; a policy only decides which
+ * occupied slot to evict. Without a policy the cache uses its built-in LRU
+ * recency list. Policies track entries by slot index and keep hashed keys
+ * for ghost (recently evicted) history.
+ *
+ * Call contract (driven by LRUCache):
+ * - onInsert(): a new entry was stored in the slot.
+ * - onAccess(): an existing entry was hit.
+ * - selectVictim(): the cache must make room for the incoming key; return an
+ *   occupied slot. onRemove() for that slot follows immediately.
+ * - onRemove(): the entry in the slot is being evicted.
+ * - reset(): drop all state (cache cleared or resized).
+ */
+class EvictionPolicy {
+public:
+    virtual ~EvictionPolicy() {}
+
+    /**
+     * @brief Display name of the policy (e.g. "ARC")
+     */
+    virtual const char* name() const = 0;
+
+    virtual void onInsert(size_t slot, const std::string& key) = 0;
+    virtual void onAccess(size_t slot) = 0;
+    virtual void onRemove(size_t slot) = 0;
+
+    /**
+     * @brief Choose the slot to evict to make room for a new entry
+     * @param incoming Key about to be inserted (empty for manual eviction)
+     * @return Occupied slot index
+     */
+    virtual size_t selectVictim(const std::string& incoming) = 0;
+
+    /**
+     * @brief Forget all entries and size internal structures for a capacity
+     */
+    virtual void reset(size_t capacity) = 0;
+};
+
+/**
+ * @brief Hash a cache key for policy bookkeeping (64-bit FNV-1a)
+ */
+uint64_t policy_key_hash(const std::string& key);
+
+/**
+ * @brief Create a replacement policy by name
+ * @param name "lru", "arc", "2q" or "tinylfu" (case-insensitive)
+ * @param capacity Cache capacity in slots
+ * @return The policy, or an empty wrapper for "lru" (the cache's native policy)
+ *         and for unknown names; use is_known_eviction_policy() to tell them apart.
+ */
+PointerWrapper<EvictionPolicy> make_eviction_policy(const std::string& name, size_t capacity);
+
+/**
+ * @brief Check whether make_eviction_policy() understands a policy name
+ */
+bool is_known_eviction_policy(const std::string& name);
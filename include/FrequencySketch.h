@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Count-Min sketch with small saturating counters and periodic aging
+ *
+ * Approximates how often each key was seen, in O(1) space per slot of cache
+ * capacity. After a sample period every counter is halved so old popularity
+ * fades. Used as TinyLFU's admission filter.
+ */
+class FrequencySketch {
+private:
+    static const size_t ROWS = 4;
+    static const uint8_t MAX_COUNT = 15;
+
+    std::vector<uint8_t> table;    // ROWS x width counters
+    size_t width_mask;             // width - 1 (width is a power of two)
+    size_t sample_size;            // increments between agings
+    size_t samples;
+
+    size_t indexOf(uint64_t key_hash, size_t row) const;
+    void age();
+
+public:
+    explicit FrequencySketch(size_t capacity = 0);
+
+    /**
+     * @brief Size the sketch for a cache capacity and clear all counts
+     */
+    void reset(size_t capacity);
+
+    void increment(uint64_t key_hash);
+    uint8_t estimate(uint64_t key_hash) const;
+};
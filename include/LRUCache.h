@@ -2,11 +2,13 @@
 
 #include "CacheSlot.h"
 #include "AudioTrack.h"
+#include "EvictionPolicy.h"
 #include "PointerWrapper.h"
 #include <vector>
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 
 /**
  * @brief LRU Cache Implementation
@@ -19,12 +21,33 @@
  * - Used by DJControllerService with fixed capacity in this assignment.
  * - get() marks entries MRU by updating their access time.
  * - put() inserts as MRU and evicts true LRU when full.
+ *
+ * Lookup and eviction are O(1): a title->slot hash index finds entries,
+ * and an intrusive doubly-linked list threaded through the CacheSlots
+ * (head = MRU, tail = LRU) keeps recency order. Empty slots are kept in a
+ * min-heap so new entries still land in the lowest free slot.
+ *
+ * An optional byte budget bounds the total memory footprint of cached
+ * tracks. When set, put() evicts as many LRU entries as needed for the
+ * newcomer to fit within both the slot and the byte limits.
+ *
+ * The replacement decision can be delegated to an EvictionPolicy (ARC, 2Q,
+ * W-TinyLFU). The cache keeps its own index and slots either way, so the
+ * get/put/evictLRU contract and return codes do not depend on the policy.
  */
 class LRUCache {
 private:
     std::vector<CacheSlot> slots;
     size_t max_size;
     uint64_t access_counter;
+    std::unordered_map<std::string, size_t> index;  // title -> slot
+    size_t mru_slot;                                 // head of recency list
+    size_t lru_slot;                                 // tail of recency list
+    size_t occupied_count;
+    std::vector<size_t> free_slots;                  // min-heap of empty slots
+    size_t max_bytes;                                // 0 = no byte budget
+    size_t used_bytes;
+    PointerWrapper<EvictionPolicy> policy;           // empty = built-in LRU
 
 public:
     /**
@@ -52,16 +75,24 @@ public:
     
     /**
      * @brief Put a track into cache (handles eviction if full)
-     * @param track Track to cache (transfers ownership).
+     * @param track Shared handle to the track; the cache keeps a reference, not a copy.
      * @return true if an eviction occurred, false otherwise.
      * 
      * If cache is full, automatically evicts the least recently
-     * used track before storing the new one.
+     * used track before storing the new one. With a byte budget, evicts
+     * LRU tracks until the new one fits; a track larger than the whole
+     * budget is not cached.
+     */
+    bool put(const TrackHandle& track);
+
+    /**
+     * @brief Put a privately owned track into cache (transfers ownership)
      */
     bool put(PointerWrapper<AudioTrack> track);
     
     /**
      * @brief Manually evict the least recently used track
+     * (or the active policy's victim)
      * @return true if a track was evicted
      */
     bool evictLRU();
@@ -80,7 +111,7 @@ public:
     /**
      * @brief Check if cache is full
      */
-    bool isFull() const { return size() >= max_size; }
+    bool isFull() const { return occupied_count >= max_size; }
     
     /**
      * @brief Clear all cache entries
@@ -96,6 +127,53 @@ public:
      * This method should be used only once.
      */
     void set_capacity(size_t capacity);
+
+    /**
+     * @brief Limit the total memory footprint of cached tracks
+     * @param bytes Budget in bytes, 0 disables the byte limit
+     * Entries are evicted in LRU order until the cache fits the new budget.
+     */
+    void set_byte_budget(size_t bytes);
+
+    /**
+     * @brief Get the byte budget (0 when disabled)
+     */
+    size_t byteBudget() const { return max_bytes; }
+
+    /**
+     * @brief Get the memory footprint of all cached tracks
+     */
+    size_t bytesUsed() const { return used_bytes; }
+
+    /**
+     * @brief Get the bytes still available under the budget
+     */
+    size_t bytesAvailable() const { return max_bytes > used_bytes ? max_bytes - used_bytes : 0; }
+
+    /**
+     * @brief Check whether a track of the given footprint can be cached at all
+     * @return false if it is larger than the whole byte budget
+     */
+    bool canFit(size_t bytes) const { return max_bytes == 0 || bytes <= max_bytes; }
+
+    /**
+     * @brief Number of entries put() would evict for a track of the given
+     * footprint, if it evicted the given slots in order
+     * Counts against both the slot capacity and the byte budget.
+     */
+    size_t evictionsNeeded(size_t incoming_bytes, const std::vector<size_t>& victims) const;
+
+    /**
+     * @brief Replace the eviction policy
+     * @param new_policy Policy to use (transfers ownership); empty restores LRU.
+     * Entries already cached are handed to the new policy in recency order.
+     */
+    void set_policy(PointerWrapper<EvictionPolicy> new_policy);
+
+    /**
+     * @brief Name of the active eviction policy ("LRU" by default)
+     */
+    const char* policyName() const;
 private:
     /**
      * @brief Find slot containing specific track
@@ -115,4 +193,36 @@ private:
      * @return Slot index, or max_size if cache is full
      */
     size_t findEmptySlot() const;
+
+    /**
+     * @brief Unlink a slot from the recency list
+     */
+    void unlink(size_t slot_idx);
+
+    /**
+     * @brief Link a slot at the MRU end of the recency list
+     */
+    void linkFront(size_t slot_idx);
+
+    /**
+     * @brief Evict one entry to make room for an incoming key
+     * @return true if a track was evicted
+     */
+    bool evictFor(const std::string& incoming);
+
+    /**
+     * @brief Check whether a track of the given size needs room to be made
+     */
+    bool needsEviction(size_t incoming_bytes) const;
+
+    /**
+     * @brief Remove a slot's entry from the index and free the slot
+     */
+    void releaseSlot(size_t slot_idx);
+
+    /**
+     * @brief Rebuild index, recency list and free heap from slot contents
+     * Used after the slot vector is resized.
+     */
+    void rebuildIndex();
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free log-linear histogram of durations in nanoseconds
+ *
+ * HDR-style bucketing: values below 2^(SUB_BITS + 1) get a bucket each;
+ * above that, every power of two is split into 2^SUB_BITS equal buckets,
+ * so a bucket spans at most 1 / 2^SUB_BITS (about 3%) of its values.
+ * The whole uint64_t range fits in BUCKETS counters, with no allocation.
+ *
+ * record() is wait-free apart from the max update (a CAS loop that only
+ * retries while another thread raises the max) and may run on a real-time
+ * thread while others read. Readers see each counter atomically but not
+ * all counters at one instant, so a percentile taken during recording is
+ * approximate. Percentiles report the upper bound of the bucket they fall
+ * in, so they never understate a latency.
+ */
+class LatencyHistogram {
+public:
+    static const unsigned SUB_BITS = 5;
+    static const size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+    static const size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Count, mean, percentiles and max read in one pass over the counters
+     * Percentiles and max describe exactly the count values that were copied;
+     * the mean divides the running sum by the running total read next to it.
+     */
+    struct Summary {
+        uint64_t count;
+        uint64_t mean;
+        uint64_t p50;
+        uint64_t p90;
+        uint64_t p99;
+        uint64_t p999;
+        uint64_t max;
+
+        Summary() : count(0), mean(0), p50(0), p90(0), p99(0), p999(0), max(0) {}
+    };
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t ns);
+
+    /**
+     * @brief Clear all counters; not safe while another thread records
+     */
+    void reset();
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return largest.load(std::memory_order_relaxed); }
+    double mean() const;
+
+    /**
+     * @brief Smallest bucket bound at or below which a fraction q of the values lie
+     * @param q In [0, 1]; 0.99 is the 99th percentile. 0 when empty.
+     */
+    uint64_t percentile(double q) const;
+
+    /**
+     * @brief Snapshot for reports; use it instead of separate count() and
+     * percentile() calls while another thread records
+     */
+    Summary summary() const;
+
+    static size_t bucket_index(uint64_t ns);
+
+    /**
+     * @brief Largest value recorded into bucket index
+     */
+    static uint64_t bucket_high(size_t index);
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> largest;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Batch analysis pass over the whole library
+ *
+ * Computes each track's quality score, beat grid and loudness (peak and RMS
+ * of the samples) and attaches them to the track as a TrackAnalysis, so that
+ * loading a track later does not pay for analysis. Tracks are spread over a
+ * ThreadPool with parallel_for(): analysis cost varies widely between tracks
+ * (beat tracking scales with the waveform), and idle workers steal from busy
+ * ones instead of waiting on a fixed split.
+ *
+ * Progress is logged at every PROGRESS_STEPS-th of the library. Samples are
+ * read in blocks through WaveformBuffer::read(), so lazy waveforms stay
+ * unmaterialized.
+ */
+class LibraryAnalyzer {
+public:
+    static const size_t GRAIN = 16;            // tracks taken per work unit
+    static const size_t PROGRESS_STEPS = 10;   // progress lines per pass (every 10%)
+    static const size_t READ_BLOCK = 1024;     // samples read at a time for loudness
+
+    /**
+     * @param threads Number of workers; 0 means ThreadPool::default_threads()
+     */
+    explicit LibraryAnalyzer(size_t threads = 0);
+
+    /**
+     * @brief Analyze every track and attach the results to it
+     * Must not run while other threads use the tracks.
+     * @return Number of tracks with a detected beat grid
+     */
+    size_t analyze(const std::vector<TrackHandle>& tracks);
+
+    /**
+     * @brief Analysis of one track, without storing it
+     */
+    static TrackAnalysis analyze_track(const AudioTrack& track);
+
+    size_t threads() const { return pool.size(); }
+
+private:
+    ThreadPool pool;
+};
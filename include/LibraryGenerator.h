@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Writes synthetic dj_config.txt files for scale testing
+ *
+ * Produces N library tracks (MP3 and WAV, varied artists, durations and
+ * BPMs) and M playlists whose lengths are uniform in [min, max]. Playlist
+ * entries are drawn from a Zipf distribution over track popularity, so a
+ * few tracks appear in many playlists, as in a real library. Popularity
+ * ranks are shuffled across library indices so popular tracks are not
+ * clustered at the top of the file. Output is deterministic for a seed.
+ */
+class LibraryGenerator {
+public:
+    struct Options {
+        size_t tracks = 1000;
+        size_t playlists = 10;
+        size_t min_playlist_length = 10;
+        size_t max_playlist_length = 50;
+        double zipf_exponent = 1.0;      // 0 = uniform popularity
+        size_t cache_size = 64;
+        uint64_t seed = 42;
+    };
+
+    /**
+     * @brief Write a configuration file
+     * @return false if the file cannot be written or the options are invalid
+     */
+    static bool write_config(const std::string& path, const Options& options);
+};
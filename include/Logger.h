@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Severity of a log line (lower is more severe)
+ */
+enum class LogLevel { Error = 0, Warn = 1, Info = 2, Debug = 3 };
+
+/**
+ * @brief Component that produced a log line
+ */
+enum class LogCategory {
+    Track = 0, Playlist, Library, Cache, Controller, Mixer, Session, Config, Parser, App,
+    Count
+};
+
+/**
+ * @brief Destination stream of a log line
+ */
+enum class LogStream { Out, Err };
+
+/**
+ * @brief Asynchronous logging sink for all console output
+ *
+ * Call sites format a line with DJ_LOG / DJ_LOG_ERR and hand it to a
+ * lock-free multi-producer queue; a background writer thread drains the
+ * queue to stdout/stderr. Text is written verbatim, in submission order,
+ * so output is byte-identical to writing through std::cout/std::cerr
+ * directly: stdout is flushed before every stderr write (as std::cerr's
+ * tie to std::cout does) and after each drained batch.
+ *
+ * Each (category, level) pair can be enabled separately. Checking whether
+ * a line is enabled is one atomic load and one branch, and a disabled line
+ * does not evaluate its arguments. By default every category logs Info
+ * and above; quiet mode keeps errors only.
+ *
+ * Call flush() before blocking on user input, so prompts are visible.
+ * The writer thread starts on first use and is drained and joined at exit.
+ */
+class Logger {
+public:
+    static bool enabled(LogLevel level, LogCategory category) {
+        return (enabled_mask.load(std::memory_order_relaxed) >> bit(level, category)) & 1;
+    }
+
+    /**
+     * @brief Enable levels up to and including threshold for every category
+     */
+    static void set_level(LogLevel threshold);
+
+    /**
+     * @brief Enable levels up to and including threshold for one category
+     */
+    static void set_category_level(LogCategory category, LogLevel threshold);
+
+    /**
+     * @brief Quiet mode logs errors only; leaving it restores Info
+     */
+    static void set_quiet(bool quiet);
+
+    /**
+     * @brief Queue text for the writer thread
+     */
+    static void submit(LogStream stream, std::string&& text);
+
+    /**
+     * @brief Block until everything submitted so far is written and flushed
+     */
+    static void flush();
+
+    /**
+     * @brief Drain the queue and stop the writer; later lines are written synchronously
+     */
+    static void shutdown();
+
+private:
+    static std::atomic<uint64_t> enabled_mask;
+
+    static unsigned bit(LogLevel level, LogCategory category) {
+        return static_cast<unsigned>(category) * 4 + static_cast<unsigned>(level);
+    }
+};
+
+/**
+ * @brief One log line under construction; submitted when destroyed
+ *
+ * Formats like std::ostream with default flags (integers in decimal,
+ * floating point as %g with precision 6). std::endl appends a newline.
+ */
+class LogLine {
+private:
+    LogStream stream;
+    std::string text;
+
+public:
+    explicit LogLine(LogStream stream) : stream(stream), text() {}
+    ~LogLine() { Logger::submit(stream, std::move(text)); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const std::string& value) { text += value; return *this; }
+    LogLine& operator<<(const char* value) { text += value; return *this; }
+    LogLine& operator<<(char value) { text += value; return *this; }
+    LogLine& operator<<(signed char value) { text += static_cast<char>(value); return *this; }
+    LogLine& operator<<(unsigned char value) { text += static_cast<char>(value); return *this; }
+    LogLine& operator<<(double value);
+    LogLine& operator<<(float value) { return *this << static_cast<double>(value); }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, LogLine&>::type
+    operator<<(T value) {
+        text += std::to_string(static_cast<long long>(value));
+        return *this;
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, LogLine&>::type
+    operator<<(T value) {
+        text += std::to_string(static_cast<unsigned long long>(value));
+        return *this;
+    }
+
+    template<typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value, LogLine&>::type
+    operator<<(const T& value) {
+        std::ostringstream out;
+        out << value;
+        text += out.str();
+        return *this;
+    }
+
+    /**
+     * @brief std::endl appends '\n'; other manipulators are ignored
+     */
+    LogLine& operator<<(std::ostream& (*manipulator)(std::ostream&));
+};
+
+/**
+ * @brief Turns the log expression into void so it fits the ?: in DJ_LOG
+ */
+struct LogVoidify {
+    void operator&(const LogLine&) {}
+};
+
+/**
+ * Usage: DJ_LOG(Info, Cache) << "text " << value << std::endl;
+ * DJ_LOG writes to stdout, DJ_LOG_ERR to stderr.
+ */
+#define DJ_LOG_TO(stream, level, category) \
+    !Logger::enabled(LogLevel::level, LogCategory::category) ? (void)0 \
+        : LogVoidify() & LogLine(stream)
+
+#define DJ_LOG(level, category) DJ_LOG_TO(LogStream::Out, level, category)
+#define DJ_LOG_ERR(level, category) DJ_LOG_TO(LogStream::Err, level, category)
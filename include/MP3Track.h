@@ -12,7 +12,8 @@
  * - load(): simulate deck preparation (format-specific message); does not start playback.
  * - analyze_beatgrid(): run immediately after load() in this assignment for compatibility checks.
  * - get_quality_score(): derived from bitrate (e.g., normalized by 320kbps).
- * - clone(): return a deep polymorphic copy used by the mixer; source remains unchanged.
+ * - clone(): return a polymorphic copy used by the mixer (waveform shared copy-on-write);
+ *   source remains unchanged.
  */
 class MP3Track : public AudioTrack {
 private:
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "StringRef.h"
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The contents stay mapped until close() or destruction; views returned
+ * by view() are invalid afterwards. The mapping is advised for sequential
+ * access. Non-copyable.
+ */
+class MappedFile {
+private:
+    void* mapping;
+    size_t length;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map path, replacing any current mapping
+     * @return false if the file cannot be opened, is not a regular file,
+     *         or cannot be mapped. An empty file maps to an empty view.
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    const char* data() const { return static_cast<const char*>(mapping); }
+    size_t size() const { return length; }
+    StringRef view() const { return StringRef(data(), length); }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Instruction sets the mixing kernels are built for
+ */
+enum class SimdLevel : uint8_t { Scalar = 0, SSE2 = 1, AVX2 = 2, AVX512 = 3 };
+
+/**
+ * @brief Inner loops of the mixer: mono double waveform samples to
+ * interleaved stereo float output, with gain, summing and clipping
+ *
+ * One table of kernels per SimdLevel; active() picks the widest level the
+ * CPU supports at run time (x86 only, other targets use Scalar). Every
+ * level does the same float operations in the same order as the scalar
+ * reference (convert each sample to float, multiply by the gain, add), so
+ * all levels produce bit-identical output.
+ *
+ * Kernels do not allocate and take unaligned pointers; out must not
+ * overlap the inputs.
+ */
+struct MixKernels {
+    SimdLevel level;
+
+    /**
+     * @brief out[2i] = out[2i + 1] = gain * in[i]
+     */
+    void (*store_stereo)(float* out, const double* in, float gain, size_t frames);
+
+    /**
+     * @brief out[2i] += gain * in[i], out[2i + 1] += gain * in[i]
+     */
+    void (*add_stereo)(float* out, const double* in, float gain, size_t frames);
+
+    /**
+     * @brief out[2i] = out[2i + 1] = gain0 * in0[i] + gain1 * in1[i]
+     */
+    void (*mix2_stereo)(float* out, const double* in0, float gain0, const double* in1, float gain1,
+                        size_t frames);
+
+    /**
+     * @brief Clamp count samples to [-limit, limit] (NaN becomes -limit)
+     */
+    void (*clip)(float* samples, size_t count, float limit);
+
+    /**
+     * @brief Kernels for the widest level this CPU supports
+     */
+    static const MixKernels& active();
+
+    /**
+     * @brief Kernels for one level; nullptr if this CPU or build does not support it
+     */
+    static const MixKernels* for_level(SimdLevel level);
+
+    static SimdLevel detected_level();
+    static const char* level_name(SimdLevel level);
+};
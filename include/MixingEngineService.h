@@ -2,19 +2,171 @@
 #define MIXINGENGINESERVICE_H
 
 #include "AudioTrack.h"
+#include "LatencyHistogram.h"
+#include "MixKernels.h"
+#include "SpscRing.h"
+#include "TimeStretcher.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
 
 // Service responsible for deck operations and track analysis
 // Phase 4 binding:
 // - Enforces instant transitions and deck alternation policy.
 // - After loading to a deck: call track.load(); then analyze_beatgrid(); then switch active deck.
 // - The previously active deck becomes finished and is unloaded immediately.
+// Preloading: preloadTrack() prepares the next track on a background worker
+// into a staging slot, so loading that track to the deck is a pointer swap.
+// Rendering: renderBlock() mixes both decks' waveform samples through
+// per-deck gains and an equal-power crossfader into interleaved stereo,
+// using the widest MixKernels the CPU supports. A deck whose tempo is not
+// 1 (auto-sync, setDeckTempo) plays through a TimeStretcher.
+// Threading: the engine is split into a control side (deck loading, the
+// setters) and a render side (renderBlock). Every change to the render
+// side is a MixCommand. Without a render thread commands apply at once;
+// with startRenderThread() they travel through a wait-free ring and apply
+// at the next block boundary, and rendered blocks come back through
+// another ring (readRenderedFrames). The render thread times every block
+// against its deadline (one block of output at the output sample rate).
 class MixingEngineService {
+public:
+    static const size_t MAX_BLOCK_FRAMES = 4096;   // frames one renderBlock() call produces at most
+    static const size_t OUTPUT_CHANNELS = 2;       // interleaved L, R
+    static const size_t COMMAND_QUEUE = 256;       // commands in flight to the render thread
+
+    /**
+     * @brief Render telemetry read at one point, for reports that print
+     * or store the same numbers
+     */
+    struct RenderTelemetry {
+        LatencyHistogram::Summary render_ns;   // time spent per block
+        uint64_t deadline_misses;
+        uint64_t underruns;
+        size_t block_frames;
+        uint64_t deadline_ns;
+
+        RenderTelemetry() : render_ns(), deadline_misses(0), underruns(0), block_frames(0), deadline_ns(0) {}
+    };
+
 private:
+    /**
+     * @brief One change to the render state, applied between blocks
+     * Plain data: the render thread copies it out of the ring and never
+     * allocates, frees or locks to apply it.
+     */
+    struct MixCommand {
+        enum Type {
+            LOAD_DECK,      // new samples on deck, from position 0 at tempo 1
+            BIND_SAMPLES,   // same track, samples bound or unbound (rendering toggled)
+            SET_GAINS,      // gain per deck, crossfader included
+            SET_POSITION,
+            SET_TEMPO
+        };
+        Type type;
+        size_t deck;
+        const double* samples;
+        size_t length;        // samples; the position for SET_POSITION
+        float gains[2];
+        double tempo;
+
+        MixCommand() : type(SET_GAINS), deck(0), samples(nullptr), length(0), gains(), tempo(1.0) {}
+    };
+
+    // ===== Control side =====
     AudioTrack* decks[2];
     size_t active_deck;
     bool auto_sync;
     int bpm_tolerance;
+    float deck_gain[2];
+    float crossfader;
+    float crossfader_gain[2];
+    bool rendering;
+    // Tempo: deck_native_bpm is the track's BPM before sync rewrote it
+    int deck_native_bpm[2];
+    double deck_tempo[2];
+
+    // ===== Render side: owned by the render thread while it runs =====
+    // While rendering is enabled, samples are bound when a track is loaded,
+    // so renderBlock() never triggers lazy waveform generation
+    const double* deck_samples[2];
+    size_t deck_length[2];
+    size_t deck_position[2];
+    float mix_gain[2];
+    double render_tempo[2];
+    const MixKernels* kernels;
+    TimeStretcher stretchers[2];
+    std::vector<double> stretch_output[2];   // MAX_BLOCK_FRAMES samples each
+
+    // ===== Render thread =====
+    std::unique_ptr<SpscRing<MixCommand>> commands;   // control -> render
+    std::unique_ptr<SpscRing<float>> output;          // render -> control, interleaved stereo
+    std::vector<float> render_buffer;                 // one block, rendered before it is queued
+    std::thread render_thread;
+    std::atomic<bool> render_running;
+    uint64_t commands_posted;
+    std::atomic<uint64_t> commands_applied;
+    std::atomic<size_t> published_position[2];       // deck_position after the last block
+    std::atomic<uint64_t> blocks_rendered;
+    // Telemetry: render time per block (commands included) against the block deadline
+    size_t render_block_frames;
+    uint64_t block_deadline_ns;
+    LatencyHistogram render_times;
+    std::atomic<uint64_t> deadline_misses;           // blocks that took longer than their deadline
+    std::atomic<uint64_t> underruns;                 // reads that found less output than asked for
+    // Unloaded tracks whose samples the render thread may still be reading,
+    // with the number of commands it must apply before they can be freed
+    std::vector<std::pair<uint64_t, AudioTrack*>> retired;
+
+    // Staging slot for the inactive deck; staged_track is written by the
+    // worker and read only after preload_done is ready
+    std::unique_ptr<ThreadPool> preload_worker;  // started on first preload
+    std::future<void> preload_done;
+    std::string preload_title;
+    PointerWrapper<AudioTrack> staged_track;
+
+    /**
+     * @brief Wait for the preload of track_title and take its track
+     * @return Empty if no preload of that title is staged, or it failed
+     */
+    PointerWrapper<AudioTrack> take_preloaded(const std::string& track_title);
+
+    /**
+     * @brief Reset a deck's playback state for the track now on it
+     */
+    void bind_deck(size_t deck);
+
+    /**
+     * @brief Point the render state of a deck at its track's samples (or at nothing)
+     */
+    void bind_samples(size_t deck);
+
+    /**
+     * @brief Hand a command to the render side: queued while the render
+     * thread runs, applied immediately otherwise
+     */
+    void post(const MixCommand& command);
+    void post_gains();
+
+    /**
+     * @brief Render side: change the render state
+     */
+    void apply(const MixCommand& command);
+    void apply_samples(size_t deck, const double* samples, size_t length);
+
+    /**
+     * @brief Delete a track taken off a deck once the render thread is done with it
+     */
+    void retire(AudioTrack* track);
+    void reclaim_retired();
+
+    void render_loop();
 public:
     MixingEngineService();
     ~MixingEngineService();
@@ -30,9 +182,154 @@ public:
      * - @return: index of the deck the track was loaded to (0 or 1), or -1 on failure.
      * - @brief: This function clones the track, unloads the target deck if needed, loads the new track, analyzes the beatgrid, switches the active deck, and unloads the previous deck.
      * - @attention: on clone failure, log an error and return
+     * - @note: if this track was preloaded, the staged copy is used and no preparation happens here
      */
     int loadTrackToDeck(const AudioTrack& track);
 
+    /** Contract: Prepare a track for the next transition in the background
+     * - @param track: library/cache handle; keeps the source alive while the worker clones it
+     * - @return: false if track is null
+     * - @brief: Clones the track, loads it, analyzes the beatgrid and (when rendering is
+     *   enabled) generates its waveform samples on a worker thread. The next loadTrackToDeck() of the same title swaps the
+     *   staged copy in. Replaces (and waits for) any earlier preload.
+     * - @attention: load() and analyze_beatgrid() log from the worker while it runs
+     */
+    bool preloadTrack(const TrackHandle& track);
+
+    /**
+     * @brief Drop the staged track, waiting for its preparation to finish
+     */
+    void cancelPreload();
+
+    /**
+     * @brief Title of the staged (or still preparing) track; empty if none
+     */
+    const std::string& getPreloadedTitle() const { return preload_title; }
+
+    /**
+     * @brief Track on a deck (0 or 1), nullptr if the deck is empty
+     */
+    const AudioTrack* getDeckTrack(size_t deck) const { return deck < 2 ? decks[deck] : nullptr; }
+    size_t getActiveDeck() const { return active_deck; }
+
+    // ========== RENDERING ==========
+
+    /**
+     * @brief Start or stop the audio side of the engine (off by default)
+     * While enabled, every track loaded to a deck has its waveform samples
+     * generated at load time (or by the preload worker), so renderBlock() never
+     * has to. While disabled, decks are not bound to samples and render silence;
+     * sessions that never render skip generating samples.
+     */
+    void setRenderingEnabled(bool enabled);
+    bool isRenderingEnabled() const { return rendering; }
+
+    /**
+     * Contract: Render the next block of the mix
+     * - @param out: caller buffer of at least frames * OUTPUT_CHANNELS floats
+     * - @return: frames written, min(frames, MAX_BLOCK_FRAMES)
+     * - @brief: Each deck contributes its next mono waveform samples scaled by its gain and
+     *   crossfader gain, copied to both channels; decks advance by the frames written.
+     *   Empty or finished decks contribute silence. Output is clipped to [-1, 1].
+     * - @attention: Real-time safe: no allocation, locking or logging; O(frames).
+     *   Without a render thread, call from the thread that loads tracks and uses
+     *   the setters. While the render thread runs, it is the only caller.
+     */
+    size_t renderBlock(float* out, size_t frames);
+
+    /**
+     * @brief Render on a dedicated thread, block_frames at a time
+     * The thread keeps up to queued_blocks blocks rendered ahead in the output
+     * ring (the output latency). Deck loads and the setters become commands
+     * applied at the next block boundary; the render loop itself takes no
+     * locks and does not allocate. Unloaded tracks are freed by the control
+     * side once the render thread has applied the command that unbound them.
+     * Does nothing if the thread is already running. Starting resets the
+     * block count and the render telemetry.
+     * @param block_frames Frames per block, at most MAX_BLOCK_FRAMES
+     * @param sample_rate Output rate; a block must render within block_frames / sample_rate
+     */
+    void startRenderThread(size_t block_frames = 256, size_t queued_blocks = 4, double sample_rate = 44100.0);
+
+    /**
+     * @brief Stop and join the render thread; rendering returns to renderBlock()
+     * Commands still queued are applied first. Unread output is dropped.
+     */
+    void stopRenderThread();
+    bool isRenderThreadRunning() const { return render_thread.joinable(); }
+
+    /**
+     * @brief Take up to frames rendered frames (interleaved stereo) from the render thread
+     * A read that gets fewer frames than asked for counts as an underrun.
+     * @return Frames copied to out; fewer when the render thread is behind, 0 when stopped
+     */
+    size_t readRenderedFrames(float* out, size_t frames);
+
+    /**
+     * @brief Blocks the render thread has queued since it was started
+     */
+    uint64_t getRenderedBlocks() const { return blocks_rendered.load(std::memory_order_relaxed); }
+
+    // ========== RENDER TELEMETRY (since startRenderThread) ==========
+
+    /**
+     * @brief Time the render thread spent on each block, in nanoseconds
+     */
+    const LatencyHistogram& getRenderTimes() const { return render_times; }
+
+    /**
+     * @brief Blocks whose render time exceeded the block deadline (xruns)
+     */
+    uint64_t getDeadlineMisses() const { return deadline_misses.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief readRenderedFrames() calls that came back short
+     */
+    uint64_t getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+
+    size_t getRenderBlockFrames() const { return render_block_frames; }
+    uint64_t getBlockDeadlineNs() const { return block_deadline_ns; }
+
+    /**
+     * @brief Snapshot of the render times, deadline misses and underruns
+     * Safe while the render thread runs; the fields are read back to back
+     * rather than atomically, so a block may count in one and not another.
+     */
+    RenderTelemetry getRenderTelemetry() const;
+
+    /**
+     * @brief Set a deck's linear gain (negative values are treated as 0)
+     */
+    void setDeckGain(size_t deck, float gain);
+    float getDeckGain(size_t deck) const { return deck < 2 ? deck_gain[deck] : 0.0f; }
+
+    /**
+     * @brief Set the crossfader: 0 = deck 0 only, 0.5 = both at -3 dB, 1 = deck 1 only
+     * Equal-power curve (cos/sin), clamped to [0, 1].
+     */
+    void setCrossfader(float position);
+    float getCrossfader() const { return crossfader; }
+
+    /**
+     * @brief Play position of a deck in samples; setDeckPosition cues it (clamped to the track)
+     * While the render thread runs, the position after its last rendered block.
+     */
+    size_t getDeckPosition(size_t deck) const;
+    void setDeckPosition(size_t deck, size_t position);
+
+    /**
+     * @brief Playback speed of a deck (1 = as recorded), time-stretched without pitch change
+     * Auto-sync sets it so the deck plays at the exact average BPM; clamped to the
+     * TimeStretcher range. No effect on an empty deck.
+     */
+    void setDeckTempo(size_t deck, double tempo);
+    double getDeckTempo(size_t deck) const { return deck < 2 ? deck_tempo[deck] : 1.0; }
+
+    /**
+     * @brief BPM a deck is heard at: its native BPM times its tempo (fractional)
+     */
+    double getDeckBpm(size_t deck) const { return deck < 2 ? deck_native_bpm[deck] * deck_tempo[deck] : 0.0; }
+
     // Display deck status
     void displayDeckStatus() const;
 
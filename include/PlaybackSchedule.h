@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Known future play order of the current playlist
+ *
+ * DJSession knows the whole track order before playing it, so the future
+ * reference string of the controller cache is exact. The schedule answers
+ * "when is this title played next?" relative to a cursor that the session
+ * advances as it plays. Used by BeladyPolicy and controller prefetching.
+ */
+class PlaybackSchedule {
+private:
+    std::vector<std::string> order;
+    std::unordered_map<uint64_t, std::vector<size_t> > positions;  // key hash -> ascending positions
+    size_t cursor;
+
+public:
+    /**
+     * @brief Returned by nextUse() for titles that are not played again
+     */
+    static const size_t NEVER = static_cast<size_t>(-1);
+
+    PlaybackSchedule();
+
+    /**
+     * @brief Replace the schedule with a new play order and rewind the cursor
+     */
+    void reset(const std::vector<std::string>& titles);
+
+    /**
+     * @brief Move the cursor to the position currently being played
+     */
+    void advance_to(size_t position) { cursor = position; }
+
+    size_t position() const { return cursor; }
+    size_t length() const { return order.size(); }
+    const std::string& titleAt(size_t position) const { return order[position]; }
+
+    /**
+     * @brief First position >= cursor at which the title is played
+     * @return Position, or NEVER
+     */
+    size_t nextUse(const std::string& title) const;
+
+    /**
+     * @brief Same as nextUse() for a key already hashed with policy_key_hash()
+     */
+    size_t nextUseOfHash(uint64_t key_hash) const;
+};
@@ -4,6 +4,7 @@
 #include "AudioTrack.h"
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 /**
  * ⚠️  WARNING: THIS CLASS HAS INTENTIONAL MEMORY LEAKS! ⚠️
@@ -15,19 +16,26 @@
  * clear ownership and safe iteration without leaks.
  */
 
-struct PlaylistNode {
-    AudioTrack* track; 
-    PlaylistNode* next;
-
-    PlaylistNode(AudioTrack* t) : track(t), next(nullptr) {}
-    ~PlaylistNode() = default;
-};
-
+/**
+ * Tracks are stored contiguously in insertion order (add_track appends).
+ * A title -> position index makes find_track O(1), and the total duration
+ * is kept as a running sum. begin()/end() iterate without allocating.
+ *
+ * Tracks are held through shared TrackHandles: copying a playlist or
+ * building one from the library shares the tracks instead of cloning them.
+ */
 class Playlist {
 private:
-    PlaylistNode* head;
+    std::vector<TrackHandle> tracks;                      // shared, in play order
+    std::unordered_map<std::string, size_t> title_index;  // title -> position of the latest track added with it
     std::string playlist_name;
     int track_count;
+    int total_duration;
+
+    /**
+     * Drop all track handles and reset the bookkeeping
+     */
+    void release_tracks();
 
 public:
     /**
@@ -41,21 +49,27 @@ public:
     ~Playlist();
 
     /**
-     * Copy Constructor
+     * Copy Constructor (shares the tracks)
      */
     Playlist(const Playlist& other);
 
     /**
-     * Copy Assignment Operator
+     * Copy Assignment Operator (shares the tracks)
      */
     Playlist& operator=(const Playlist& other);
 
     /**
-     * Add a track to the playlist
+     * Append a track to the end of the playlist (takes ownership)
      * @param track Pointer to AudioTrack to add
      */
     void add_track(AudioTrack* track);
 
+    /**
+     * Append a shared track to the end of the playlist
+     * @param track Handle to the track (e.g. a library entry)
+     */
+    void add_track(const TrackHandle& track);
+
     /**
      * Remove a track by title
      * @param title Title of the track to remove
@@ -81,21 +95,39 @@ public:
      */
     AudioTrack* find_track(const std::string& title) const;
 
+    /**
+     * @brief Find a track by title and return a shared handle to it
+     * @return Handle to the found track, or an empty handle if not found
+     */
+    TrackHandle find_track_handle(const std::string& title) const;
+
     /**
      * Check if playlist is empty
      */
-    bool is_empty() const { return head == nullptr; }
+    bool is_empty() const { return tracks.empty(); }
 
     /**
      * Calculate total duration of all tracks
      */
-    int get_total_duration() const;
+    int get_total_duration() const { return total_duration; }
 
     /**
      * Get all tracks as a vector
      */
     std::vector<AudioTrack*> getTracks() const;
 
+    /**
+     * Iterate tracks in play order without copying
+     */
+    typedef std::vector<TrackHandle>::const_iterator const_iterator;
+    const_iterator begin() const { return tracks.begin(); }
+    const_iterator end() const { return tracks.end(); }
+
+    /**
+     * Track at a 0-based position (no bounds check)
+     */
+    AudioTrack* track_at(size_t position) const { return tracks[position].get(); }
+
 };
 
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Doubly-linked recency list over cache slot indices
+ *
+ * Building block for replacement policies. Front is most recent, back is
+ * least recent. All operations are O(1); a slot is in at most one position.
+ */
+class SlotList {
+private:
+    std::vector<size_t> prev;
+    std::vector<size_t> next;
+    std::vector<bool> member;
+    size_t head;
+    size_t tail;
+    size_t count;
+
+public:
+    static const size_t NONE = static_cast<size_t>(-1);
+
+    explicit SlotList(size_t capacity = 0);
+
+    /**
+     * @brief Empty the list and size it for slot indices below capacity
+     */
+    void reset(size_t capacity);
+
+    void pushFront(size_t slot);
+    void remove(size_t slot);
+    bool contains(size_t slot) const { return slot < member.size() && member[slot]; }
+
+    /**
+     * @brief Least recent slot, or NONE when empty
+     */
+    size_t back() const { return tail; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * @brief Bounded history of evicted keys (by hash) in recency order
+ *
+ * Used by ARC and 2Q to recognise keys that return shortly after eviction.
+ */
+class GhostList {
+private:
+    std::list<uint64_t> order;   // front = most recent
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> lookup;
+
+public:
+    GhostList();
+
+    void pushFront(uint64_t key);
+    bool remove(uint64_t key);
+    bool contains(uint64_t key) const { return lookup.count(key) != 0; }
+    void popBack();
+    void clear();
+    size_t size() const { return lookup.size(); }
+    bool empty() const { return lookup.empty(); }
+};
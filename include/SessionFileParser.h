@@ -3,7 +3,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <fstream>
+#include "StringRef.h"
+
+class SnapshotTrackTable;
 
 /**
  * @brief Configuration data parsed from DJ session config files
@@ -33,9 +37,21 @@ struct SessionConfig {
     };
     
     std::vector<TrackInfo> library_tracks;
+
+    // Set instead of library_tracks when the config came from a snapshot
+    std::shared_ptr<const SnapshotTrackTable> snapshot_tracks;
+
+    /**
+     * @brief Number of library tracks, in whichever form the config holds them
+     */
+    size_t library_size() const;
     
     // Cache settings
     int controller_cache_size;
+    size_t controller_cache_bytes;   // 0 = no byte budget
+    std::string cache_policy;        // lru, arc, 2q or tinylfu
+    int controller_lookahead;        // prefetch window for Belady mode, 0 = off
+    int controller_cache_shards;     // independently locked cache shards
     
     // Mixing settings
     int default_crossfade_time;
@@ -48,7 +64,12 @@ struct SessionConfig {
         : app_name(""), 
           version(""), 
           library_tracks(), 
+          snapshot_tracks(), 
           controller_cache_size(8), 
+          controller_cache_bytes(0), 
+          cache_policy("lru"), 
+          controller_lookahead(0), 
+          controller_cache_shards(1), 
           default_crossfade_time(5), 
           bpm_tolerance(10), 
           auto_sync(true), 
@@ -75,6 +96,17 @@ struct PlaylistData {
     std::vector<PlaylistTrack> tracks;
 };
 
+/**
+ * @brief How parse_config_file reads the configuration file
+ *
+ * Stream reads line by line with std::getline. Mapped memory-maps the file
+ * and tokenizes in place, allocating only the parsed track strings and
+ * playlist vectors. Parallel maps the file too and parses library_track
+ * lines of newline-aligned chunks on a thread pool. All modes produce the
+ * same SessionConfig and the same warnings, in line order.
+ */
+enum class ParserMode { Stream, Mapped, Parallel };
+
 /**
  * @brief File parser for DJ session configuration and playlist files
  * 
@@ -98,12 +130,29 @@ public:
      * library_track_1=MP3,title,{artist1;artist2;},duration,bpm,bitrate,has_tags
      * library_track_2=WAV,title,{artist1;artist2;},duration,bpm,sample_rate,bit_depth
      * controller_cache_size=8
+     * controller_cache_bytes=65536   (optional byte budget, 0 = none)
+     * cache_policy=lru               (lru, arc, 2q or tinylfu)
+     * controller_lookahead=4         (prefetch window, Belady eviction; 0 = off)
+     * controller_cache_shards=1      (independently locked cache shards)
      * bpm_tolerance=10
      * auto_sync=true
      * playlistname=1,2,3
      */
     static bool parse_config_file(const std::string& config_path, SessionConfig& config);
     
+    /**
+     * @brief Select the parser used by parse_config_file (default: Parallel)
+     * Mapped and Parallel fall back to Stream for files that cannot be mapped,
+     * such as pipes. Parallel parses serially with one thread or small files.
+     */
+    static void set_parser_mode(ParserMode mode);
+    static ParserMode parser_mode();
+    
+    /**
+     * @brief Worker threads for Parallel mode; 0 (default) uses hardware concurrency
+     */
+    static void set_parser_threads(size_t threads);
+    
     /**
      * @brief Parse a playlist file
      * @param playlist_path Path to the .playlist file
@@ -132,6 +181,53 @@ public:
     static bool validate_track_format(const std::string& line);
 
 private:
+    static ParserMode mode;
+    static size_t parser_threads;
+    
+    /**
+     * @brief Parsed library tracks and deferred lines of one chunk (Parallel mode)
+     */
+    struct ParsedChunk;
+    
+    /**
+     * @brief Parse a configuration file read line by line
+     */
+    static bool parse_config_stream(const std::string& config_path, SessionConfig& config);
+    
+    /**
+     * @brief Parse configuration text held in memory (a mapped file)
+     */
+    static bool parse_config_mapped(StringRef text, SessionConfig& config);
+    
+    /**
+     * @brief Parse configuration text in newline-aligned chunks on a thread pool
+     * Tracks are merged in file order; other lines are applied serially in order.
+     */
+    static bool parse_config_parallel(StringRef text, size_t threads, SessionConfig& config);
+    
+    /**
+     * @brief Parse the library_track lines of one chunk; defer everything else
+     */
+    static void parse_chunk(StringRef text, ParsedChunk& chunk);
+    
+    /**
+     * @brief Apply one trimmed, non-empty, non-comment configuration line
+     */
+    static void apply_line(StringRef line, int line_number, SessionConfig& config);
+    
+    /**
+     * @brief Apply a named setting (app_name, cache and mixing keys)
+     * @return false if key is not a setting; config is left unchanged
+     */
+    static bool apply_setting(StringRef key, StringRef value, int line_number, SessionConfig& config);
+    
+    /**
+     * @brief Parse a decimal int with std::stoi semantics, without exceptions
+     * Leading whitespace and a sign are accepted and trailing characters are
+     * ignored; fails when there are no digits or the value overflows int.
+     */
+    static bool parse_int(StringRef text, int& value);
+    
     /**
      * @brief Split a string by delimiter
      * @param str String to split
@@ -178,6 +274,11 @@ private:
      */
     static bool parse_library_track(const std::string& line, SessionConfig::TrackInfo& track_info);
     
+    /**
+     * @brief Allocation-free tokenizing variant of parse_library_track
+     */
+    static bool parse_library_track(StringRef line, SessionConfig::TrackInfo& track_info);
+    
     /**
      * @brief Parse artist list from {artist1;artist2;...} format
      * @param artist_str String containing artists in curly braces
@@ -185,6 +286,11 @@ private:
      */
     static std::vector<std::string> parse_artist_list(const std::string& artist_str);
     
+    /**
+     * @brief Parse artist list into artists, allocating only the names
+     */
+    static void parse_artist_list(StringRef artist_str, std::vector<std::string>& artists);
+    
     /**
      * @brief Parse playlist line from config (playlist_name=1,2,3)
      * @param line Playlist line from config
@@ -194,6 +300,13 @@ private:
      */
     static bool parse_playlist_line(const std::string& line, std::string& playlist_name, std::vector<int>& track_indices);
     
+    /**
+     * @brief Parse the comma-separated indices of playlist_name
+     * Invalid indices are skipped with a warning, as in parse_playlist_line.
+     * @return true if at least one index was parsed
+     */
+    static bool parse_playlist_indices(StringRef playlist_name, StringRef value, std::vector<int>& track_indices);
+    
     /**
      * @brief Parse track line from playlist
      * @param line Track line from playlist file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Wait-free single-producer/single-consumer ring buffer
+ *
+ * One thread pushes and one thread pops. Every operation finishes in a
+ * bounded number of steps without locking, and nothing allocates after
+ * construction, so either side may be a real-time thread.
+ *
+ * head and tail are free-running counters; only their difference is used,
+ * so wrapping around is harmless. Each is written by one side only: the
+ * producer publishes slots with a release store of tail, the consumer
+ * hands them back with a release store of head. Each side keeps a cached
+ * copy of the other's counter and reloads it only when the ring looks full
+ * (or empty), and the two counters sit on separate cache lines.
+ *
+ * T must be default-constructible and copy-assignable; all slots are
+ * constructed up front.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @param capacity Minimum number of items held; rounded up to a power of two
+     */
+    explicit SpscRing(size_t capacity)
+        : slots(round_up(capacity)), mask(slots.size() - 1), shared_pad(),
+          head(0), cached_tail(0), consumer_pad(), tail(0), cached_head(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return slots.size(); }
+
+    // ========== PRODUCER SIDE ==========
+
+    bool push(const T& item) { return push(&item, 1) == 1; }
+
+    /**
+     * @brief Append up to count items
+     * @return Items appended; fewer than count when the ring fills up
+     */
+    size_t push(const T* items, size_t count) {
+        const size_t back = tail.load(std::memory_order_relaxed);
+        if (capacity() - (back - cached_head) < count) {
+            cached_head = head.load(std::memory_order_acquire);
+        }
+        count = std::min(count, capacity() - (back - cached_head));
+        const size_t start = back & mask;
+        const size_t first = std::min(count, capacity() - start);
+        std::copy(items, items + first, slots.begin() + start);
+        std::copy(items + first, items + count, slots.begin());
+        tail.store(back + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Slots the producer can fill right now
+     */
+    size_t free_space() {
+        cached_head = head.load(std::memory_order_acquire);
+        return capacity() - (tail.load(std::memory_order_relaxed) - cached_head);
+    }
+
+    // ========== CONSUMER SIDE ==========
+
+    bool pop(T& item) { return pop(&item, 1) == 1; }
+
+    /**
+     * @brief Remove up to count items, oldest first
+     * @return Items removed; fewer than count when the ring runs empty
+     */
+    size_t pop(T* items, size_t count) {
+        const size_t front = head.load(std::memory_order_relaxed);
+        if (cached_tail - front < count) {
+            cached_tail = tail.load(std::memory_order_acquire);
+        }
+        count = std::min(count, cached_tail - front);
+        const size_t start = front & mask;
+        const size_t first = std::min(count, capacity() - start);
+        std::copy(slots.begin() + start, slots.begin() + start + first, items);
+        std::copy(slots.begin(), slots.begin() + (count - first), items + first);
+        head.store(front + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Items the consumer can take right now
+     */
+    size_t available() {
+        cached_tail = tail.load(std::memory_order_acquire);
+        return cached_tail - head.load(std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t CACHE_LINE = 64;
+
+    static size_t round_up(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    std::vector<T> slots;
+    const size_t mask;
+    char shared_pad[CACHE_LINE];
+
+    // Consumer-owned line: head, and the consumer's view of tail
+    std::atomic<size_t> head;
+    size_t cached_tail;
+    char consumer_pad[CACHE_LINE];
+
+    // Producer-owned line: tail, and the producer's view of head
+    std::atomic<size_t> tail;
+    size_t cached_head;
+};
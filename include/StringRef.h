@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Non-owning view of a character range (pointer + length)
+ *
+ * A minimal stand-in for std::string_view, which is not available in
+ * C++11. Copying a StringRef never copies characters; the referenced
+ * storage must outlive every view into it.
+ */
+struct StringRef {
+    static const size_t npos = static_cast<size_t>(-1);
+
+    const char* data;
+    size_t size;
+
+    StringRef() : data(nullptr), size(0) {}
+    StringRef(const char* data, size_t size) : data(data), size(size) {}
+    StringRef(const std::string& str) : data(str.data()), size(str.size()) {}
+
+    bool empty() const { return size == 0; }
+    char front() const { return data[0]; }
+    char back() const { return data[size - 1]; }
+    char operator[](size_t pos) const { return data[pos]; }
+
+    /**
+     * @brief View of [pos, pos + count), clamped to the end
+     */
+    StringRef substr(size_t pos, size_t count = npos) const {
+        if (pos > size) pos = size;
+        if (count > size - pos) count = size - pos;
+        return StringRef(data + pos, count);
+    }
+
+    /**
+     * @brief Position of the first c at or after pos, or npos
+     */
+    size_t find(char c, size_t pos = 0) const {
+        if (pos >= size) return npos;
+        const void* hit = std::memchr(data + pos, c, size - pos);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : npos;
+    }
+
+    bool starts_with(const char* prefix) const {
+        size_t length = std::strlen(prefix);
+        return length <= size && std::memcmp(data, prefix, length) == 0;
+    }
+
+    bool operator==(const char* str) const {
+        size_t length = std::strlen(str);
+        return length == size && std::memcmp(data, str, length) == 0;
+    }
+    bool operator!=(const char* str) const { return !(*this == str); }
+
+    /**
+     * @brief Strip spaces, tabs, newlines and carriage returns from both ends
+     */
+    StringRef trim() const {
+        size_t start = 0;
+        size_t end = size;
+        while (start < end && is_trim_space(data[start])) ++start;
+        while (end > start && is_trim_space(data[end - 1])) --end;
+        return StringRef(data + start, end - start);
+    }
+
+    std::string str() const { return std::string(data, size); }
+
+private:
+    static bool is_trim_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+};
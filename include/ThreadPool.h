@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads running queued tasks
+ *
+ * Tasks run in submission order (FIFO) on whichever worker is free. The
+ * returned future becomes ready when the task finishes and rethrows any
+ * exception it raised. Destruction finishes the queued tasks, then joins.
+ *
+ * parallel_for() spreads an index range over all workers; a worker whose
+ * share runs out steals half of another worker's remaining share.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    void worker_loop();
+
+public:
+    /**
+     * @param threads Number of workers; 0 means default_threads()
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::future<void> submit(std::function<void()> task);
+
+    /**
+     * @brief Run body over the indices [0, count) on every worker and wait
+     * Each worker starts with an equal contiguous share and takes up to
+     * grain indices at a time from its front; a worker with nothing left
+     * steals the back half of the next non-empty share. body(begin, end)
+     * runs concurrently on disjoint ranges. The first exception thrown by
+     * body is rethrown once every worker has stopped; indices left in the
+     * failing worker's share may then be skipped. Must not be called from
+     * a task running on this pool.
+     */
+    void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Hardware concurrency, at least 1
+     */
+    static size_t default_threads();
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Streaming WSOLA time-stretcher: changes tempo, keeps pitch
+ *
+ * Waveform-similarity overlap-add over a mono source held in memory.
+ * Output is built from Hann-windowed frames of FRAME samples overlapped by
+ * half (HOP). Frame k is nominally read at input position k * HOP * ratio;
+ * the actual position is moved within +/- TOLERANCE samples to where the
+ * input best continues the previous frame (cross-correlation over the
+ * overlap, coarse search then refinement), which avoids phase jumps.
+ *
+ * Output is produced in blocks of any size. Each frame reads input only in
+ * [nominal - TOLERANCE, nominal + TOLERANCE + FRAME), so the lookahead is
+ * bounded; reads outside the source are silence. The ratio may change
+ * between blocks and need not be a whole number of BPM. process() does
+ * not allocate: all buffers are sized in the constructor.
+ */
+class TimeStretcher {
+public:
+    static const size_t FRAME = 1024;
+    static const size_t HOP = FRAME / 2;
+    static const size_t TOLERANCE = 256;
+    static const size_t LOOKAHEAD = TOLERANCE + FRAME;   // input read past the nominal position
+    static constexpr double MIN_RATIO = 0.25;
+    static constexpr double MAX_RATIO = 4.0;
+
+    TimeStretcher();
+
+    // Copies share the (non-owned) source and continue independently
+    TimeStretcher(const TimeStretcher&) = default;
+    TimeStretcher& operator=(const TimeStretcher&) = default;
+
+    /**
+     * @brief Start stretching source at an input position (samples)
+     * The source must outlive the stretcher's use of it; nullptr detaches.
+     */
+    void reset(const double* source, size_t length, double position);
+
+    /**
+     * @brief Playback speed: input samples per output sample (> 1 is faster)
+     * Clamped to [MIN_RATIO, MAX_RATIO].
+     */
+    void set_ratio(double ratio);
+    double ratio() const { return speed; }
+
+    /**
+     * @brief The ratio set_ratio() would store for ratio
+     */
+    static double clamp_ratio(double ratio);
+
+    /**
+     * @brief Input position the next output sample corresponds to
+     */
+    double position() const;
+
+    /**
+     * @brief True once the source is used up; process() then returns 0
+     */
+    bool finished() const { return ready == 0 && (!source || nominal >= static_cast<double>(length)); }
+
+    /**
+     * @brief Write up to frames stretched samples to out
+     * @return Samples written; fewer than frames only when the source runs out
+     */
+    size_t process(double* out, size_t frames);
+
+private:
+    const double* source;
+    size_t length;
+    double speed;
+    double nominal;          // nominal input position of the next frame
+    long long previous;      // actual input position of the last frame
+    bool has_previous;
+    std::vector<double> window;
+    std::vector<double> overlap;   // FRAME samples: the emitting half, then the tail of the last frame
+    size_t emitted;                // samples of the current HOP already written out
+    size_t ready;                  // samples of the current HOP still to write
+    std::vector<double> region;    // input around the nominal position, zero-padded
+    std::vector<double> target;    // natural continuation of the last frame
+
+    /**
+     * @brief Copy source[start, start + count) to out, zeros outside the source
+     */
+    void fetch(long long start, size_t count, double* out) const;
+
+    /**
+     * @brief Overlap-add the next frame; false once the source is used up
+     */
+    bool synthesize();
+
+    /**
+     * @brief Position in [center - TOLERANCE, center + TOLERANCE] that best continues the last frame
+     */
+    long long best_position(long long center);
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Which track fields a search matches
+ */
+enum class SearchField : uint8_t { Title = 1, Artist = 2, Any = 3 };
+
+/**
+ * @brief Inverted index over library titles and artists
+ *
+ * Text is split into tokens at every character that is not an ASCII
+ * letter or digit (bytes of UTF-8 sequences stay inside tokens) and ASCII
+ * letters are case-folded. Each token has one posting list of library
+ * indices in ascending order, each tagged with the fields it occurs in.
+ *
+ * Tracks are added incrementally with ascending library indices, so
+ * posting lists are appended to, never re-sorted. The vocabulary used for
+ * prefix lookups is sorted lazily: tokens added since the last prefix
+ * query are sorted and merged in on the next one, or by sort_vocabulary().
+ * Queries are therefore not safe to run concurrently with add(), or with
+ * each other while tokens are pending; after sort_vocabulary() they only
+ * read.
+ *
+ * Results are library indices (0-based positions in the library vector),
+ * ascending.
+ */
+class TrackSearchIndex {
+public:
+    TrackSearchIndex();
+
+    /**
+     * @brief Index one track; library_index must exceed every index added before
+     * @return false (and nothing is indexed) if the index is out of order
+     */
+    bool add(uint32_t library_index, const std::string& title, const std::vector<std::string>& artists);
+
+    void clear();
+
+    /**
+     * @brief Merge tokens added since the last prefix query into the sorted vocabulary
+     */
+    void sort_vocabulary() { merge_pending_tokens(); }
+
+    size_t track_count() const { return tracks; }
+    size_t token_count() const { return tokens.size(); }
+
+    /**
+     * @brief Tracks matching every token of query in field
+     * Autocomplete semantics: the last token matches as a prefix unless the
+     * query ends with a separator ("dua li" matches "Dua Lipa").
+     */
+    std::vector<uint32_t> search(const std::string& query, SearchField field = SearchField::Any,
+                                 size_t limit = 20) const;
+
+    /**
+     * @brief Tracks credited to all of the given artists
+     * Every token of every artist name must occur in the track's artists.
+     */
+    std::vector<uint32_t> find_by_artists(const std::vector<std::string>& artists, size_t limit = 20) const;
+
+    /**
+     * @brief Indexed tokens starting with prefix (case-folded), in lexicographic order
+     */
+    std::vector<std::string> complete(const std::string& prefix, size_t limit = 10) const;
+
+    /**
+     * @brief Case-folded tokens of text, in order (duplicates kept)
+     */
+    static std::vector<std::string> tokenize(const std::string& text);
+
+private:
+    static const uint32_t FIELD_BITS = 2;
+    static const uint32_t MAX_LIBRARY_INDEX = UINT32_MAX >> FIELD_BITS;
+
+    std::unordered_map<std::string, uint32_t> token_ids;
+    std::vector<std::string> tokens;                 // token id -> text
+    std::vector<std::vector<uint32_t>> postings;     // token id -> (library index << 2) | field bits
+    size_t tracks;
+    int64_t last_index;
+
+    // Token ids in lexicographic order of their text; ids >= sorted_count are pending
+    mutable std::vector<uint32_t> sorted_tokens;
+    mutable size_t sorted_count;
+
+    void add_tokens(const std::string& text, uint32_t entry, std::string& token);
+    void add_token(const std::string& token, uint32_t entry);
+    void merge_pending_tokens() const;
+
+    /**
+     * @brief Token ids whose text starts with prefix, as a range of sorted_tokens
+     */
+    void prefix_range(const std::string& prefix, size_t& begin, size_t& end) const;
+
+    /**
+     * @brief Intersect exact posting lists with the union of prefix posting lists
+     * Either list set may be empty (no prefix term / no exact terms), not both.
+     */
+    std::vector<uint32_t> match(std::vector<const std::vector<uint32_t>*> exact,
+                                const std::vector<const std::vector<uint32_t>*>& prefix,
+                                uint32_t field_mask, size_t limit) const;
+};
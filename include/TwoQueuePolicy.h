@@ -0,0 +1,34 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include "PolicyLists.h"
+#include <vector>
+
+/**
+ * @brief Full 2Q replacement (Johnson & Shasha)
+ *
+ * New entries enter A1in, a small FIFO; hits there are treated as correlated
+ * and do not promote. Entries evicted from A1in are remembered in the ghost
+ * queue A1out; a key that comes back while in A1out is admitted to Am, the
+ * main LRU queue. One-pass scans therefore churn through A1in only.
+ */
+class TwoQueuePolicy : public EvictionPolicy {
+private:
+    size_t capacity;
+    size_t kin;                    // target size of A1in (~25%)
+    size_t kout;                   // size of the A1out ghost queue (~50%)
+    SlotList a1in;
+    SlotList am;
+    GhostList a1out;
+    std::vector<uint64_t> keys;    // hashed key per slot
+
+public:
+    explicit TwoQueuePolicy(size_t capacity);
+
+    const char* name() const override { return "2Q"; }
+    void onInsert(size_t slot, const std::string& key) override;
+    void onAccess(size_t slot) override;
+    void onRemove(size_t slot) override;
+    size_t selectVictim(const std::string& incoming) override;
+    void reset(size_t capacity) override;
+};
@@ -12,7 +12,8 @@
  * - load(): simulate deck preparation for WAV (often faster due to no decompression).
  * - analyze_beatgrid(): run immediately after load() in this assignment; can be more precise.
  * - get_quality_score(): derived from sample_rate and bit_depth (higher => better).
- * - clone(): return a deep polymorphic copy used by the mixer; source remains unchanged.
+ * - clone(): return a polymorphic copy used by the mixer (waveform shared copy-on-write);
+ *   source remains unchanged.
  * - get_quality_score(): function of sample_rate and bit_depth (both higher -> better).
  */
 class WAVTrack : public AudioTrack {
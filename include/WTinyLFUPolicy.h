@@ -0,0 +1,39 @@
+#pragma once
+
+#include "EvictionPolicy.h"
+#include "FrequencySketch.h"
+#include "PolicyLists.h"
+#include <vector>
+
+/**
+ * @brief Window TinyLFU replacement (Einziger, Friedman & Manes)
+ *
+ * New entries enter a small LRU window (~1% of capacity). The main region
+ * is a segmented LRU: probation (~20%) and protected (~80%). When the
+ * window overflows, its LRU candidate competes with the probation victim
+ * and the one with the lower estimated frequency (FrequencySketch) is
+ * evicted, so recent one-hit entries cannot push out popular ones.
+ */
+class WTinyLFUPolicy : public EvictionPolicy {
+private:
+    size_t capacity;
+    size_t window_capacity;
+    size_t protected_capacity;
+    SlotList window;
+    SlotList probation;
+    SlotList protected_list;
+    FrequencySketch sketch;
+    std::vector<uint64_t> keys;    // hashed key per slot
+
+    size_t mainVictim() const;
+
+public:
+    explicit WTinyLFUPolicy(size_t capacity);
+
+    const char* name() const override { return "W-TinyLFU"; }
+    void onInsert(size_t slot, const std::string& key) override;
+    void onAccess(size_t slot) override;
+    void onRemove(size_t slot) override;
+    size_t selectVictim(const std::string& incoming) override;
+    void reset(size_t capacity) override;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief Reference-counted, copy-on-write waveform sample buffer
+ *
+ * Copying a WaveformBuffer shares the underlying sample array in O(1), so
+ * AudioTrack clones (library -> playlist -> cache -> deck) no longer copy
+ * their waveform. Read access through data() never copies. The first
+ * mutable_data() call on a shared buffer detaches it into a private copy.
+ *
+ * A buffer can also be synthesized lazily: synthesized() records only the
+ * size and a seed, and the samples are generated on first access from a
+ * counter-based PRNG (sample i depends only on seed and i). Clones share the
+ * pending block, so the samples are generated at most once for all of them,
+ * and the same seed always yields the same samples.
+ *
+ * The reference count is atomic and lazy generation runs under
+ * std::call_once, so buffers may be shared between threads; detaching a
+ * buffer is not synchronized with concurrent writers of the same handle.
+ *
+ * content_hash() identifies the samples themselves, not the handle: equal
+ * samples hash equal whether lazy or materialized. It is computed once per
+ * sample array and recomputed after mutable_data() hands out write access.
+ */
+class WaveformBuffer {
+private:
+    struct Block {
+        std::atomic<size_t> refs;
+        size_t size;
+        double* samples;
+        uint64_t seed;
+        bool lazy;                 // samples are the seed's, synthesized on first access
+        std::once_flag generated;
+        std::atomic<uint64_t> hash;   // memoized content_hash(); 0 until computed
+
+        explicit Block(size_t size);
+        Block(size_t size, uint64_t seed);
+        ~Block();
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+    };
+
+    Block* block;
+
+    void release();
+
+    /**
+     * @brief Generate pending lazy samples (no-op once generated)
+     */
+    static void materialize(Block* block);
+
+    static std::atomic<size_t> allocations;
+
+public:
+    /**
+     * @brief Empty buffer (size 0, no allocation)
+     */
+    WaveformBuffer();
+
+    /**
+     * @brief Allocate a zero-filled buffer of the given number of samples
+     */
+    explicit WaveformBuffer(size_t size);
+
+    ~WaveformBuffer();
+
+    /**
+     * @brief Share other's samples (O(1), no copy)
+     */
+    WaveformBuffer(const WaveformBuffer& other);
+    WaveformBuffer& operator=(const WaveformBuffer& other);
+
+    WaveformBuffer(WaveformBuffer&& other) noexcept;
+    WaveformBuffer& operator=(WaveformBuffer&& other) noexcept;
+
+    /**
+     * @brief Buffer whose samples are generated on first access
+     * @param size Number of samples
+     * @param seed PRNG seed; equal seeds give identical samples
+     */
+    static WaveformBuffer synthesized(size_t size, uint64_t seed);
+
+    /**
+     * @brief Sample i of the deterministic synthetic waveform, in [-1, 1)
+     * Counter-based: splitmix64 of (seed, i), so any sample can be computed independently.
+     */
+    static double synthetic_sample(uint64_t seed, size_t i);
+
+    /**
+     * @brief Read-only samples (nullptr when empty); generates lazy samples
+     */
+    const double* data() const;
+
+    /**
+     * @brief Copy samples [offset, offset + count) to out, zeros past the end
+     * Lazy samples that are not materialized yet are synthesized into out
+     * without materializing the buffer.
+     */
+    void read(size_t offset, double* out, size_t count) const;
+
+    /**
+     * @brief 64-bit hash of the size and sample values (0 when empty)
+     * Does not materialize lazy samples.
+     */
+    uint64_t content_hash() const;
+
+    /**
+     * @brief Check whether the samples exist in memory yet
+     */
+    bool is_materialized() const;
+
+    /**
+     * @brief Writable samples; copies the array first if it is shared
+     * Forgets the memoized content hash, since the caller may write.
+     */
+    double* mutable_data();
+
+    size_t size() const { return block ? block->size : 0; }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Number of handles sharing these samples (0 when empty)
+     */
+    size_t use_count() const;
+
+    /**
+     * @brief Total sample arrays allocated in this process (new + detach copies)
+     */
+    static size_t allocation_count();
+};
@@ -0,0 +1,101 @@
+#include "ARCPolicy.h"
+#include <algorithm>
+
+ARCPolicy::ARCPolicy(size_t capacity)
+    : capacity(capacity), target_t1(0), t1(capacity), t2(capacity), b1(), b2(),
+      keys(capacity, 0), adapted_key(0), has_adapted(false), drop_next_ghost(false) {}
+
+void ARCPolicy::reset(size_t new_capacity) {
+    capacity = new_capacity;
+    target_t1 = 0;
+    t1.reset(capacity);
+    t2.reset(capacity);
+    b1.clear();
+    b2.clear();
+    keys.assign(capacity, 0);
+    has_adapted = false;
+    drop_next_ghost = false;
+}
+
+void ARCPolicy::adapt(uint64_t key) {
+    // A ghost hit in B1 means T1 was too small; in B2, T2 was too small
+    if (b1.contains(key)) {
+        size_t delta = std::max<size_t>(b1.size() ? b2.size() / b1.size() : 1, 1);
+        target_t1 = std::min(capacity, target_t1 + delta);
+    } else if (b2.contains(key)) {
+        size_t delta = std::max<size_t>(b2.size() ? b1.size() / b2.size() : 1, 1);
+        target_t1 = (target_t1 > delta) ? target_t1 - delta : 0;
+    } else {
+        return;
+    }
+    adapted_key = key;
+    has_adapted = true;
+}
+
+size_t ARCPolicy::replace(uint64_t key) const {
+    // ARC's REPLACE: evict from T1 when it exceeds its target, else from T2
+    bool t1_over = t1.size() > target_t1 || (b2.contains(key) && t1.size() == target_t1);
+    if (!t1.empty() && (t1_over || t2.empty())) {
+        return t1.back();
+    }
+    return t2.back();
+}
+
+size_t ARCPolicy::selectVictim(const std::string& incoming) {
+    uint64_t key = policy_key_hash(incoming);
+    // A byte-budgeted insert may evict several entries; p moves once per ghost hit
+    if (!has_adapted || adapted_key != key) adapt(key);
+
+    if (!b1.contains(key) && !b2.contains(key) && t1.size() + b1.size() >= capacity) {
+        if (t1.size() < capacity) {
+            b1.popBack();
+        } else {
+            // L1 holds only resident pages: evict T1's LRU without a ghost
+            drop_next_ghost = true;
+            return t1.back();
+        }
+    }
+    return replace(key);
+}
+
+void ARCPolicy::onInsert(size_t slot, const std::string& key) {
+    uint64_t hashed = policy_key_hash(key);
+    if (slot >= keys.size()) keys.resize(slot + 1, 0);
+    keys[slot] = hashed;
+
+    if (b1.contains(hashed) || b2.contains(hashed)) {
+        // Returning key: adapt p (unless selectVictim already did) and promote
+        if (!has_adapted || adapted_key != hashed) adapt(hashed);
+        b1.remove(hashed);
+        b2.remove(hashed);
+        t2.pushFront(slot);
+    } else {
+        t1.pushFront(slot);
+    }
+    has_adapted = false;
+    trimGhosts();
+}
+
+void ARCPolicy::onAccess(size_t slot) {
+    // Any hit makes the entry frequent
+    t1.remove(slot);
+    t2.pushFront(slot);
+}
+
+void ARCPolicy::onRemove(size_t slot) {
+    if (t1.contains(slot)) {
+        t1.remove(slot);
+        if (!drop_next_ghost) b1.pushFront(keys[slot]);
+    } else if (t2.contains(slot)) {
+        t2.remove(slot);
+        b2.pushFront(keys[slot]);
+    }
+    drop_next_ghost = false;
+    trimGhosts();
+}
+
+void ARCPolicy::trimGhosts() {
+    // |T1| + |B1| <= c and the whole directory <= 2c
+    while (!b1.empty() && t1.size() + b1.size() > capacity) b1.popBack();
+    while (!b2.empty() && t1.size() + t2.size() + b1.size() + b2.size() > 2 * capacity) b2.popBack();
+}
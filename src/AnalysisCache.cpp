@@ -0,0 +1,43 @@
+#include "AnalysisCache.h"
+#include "Logger.h"
+#include "WaveformBuffer.h"
+#include <cstring>
+
+AnalysisCache::AnalysisCache() : lock(), entries(), runs(0), undetected() {}
+
+AnalysisCache& AnalysisCache::instance() {
+    static AnalysisCache cache;
+    return cache;
+}
+
+size_t AnalysisCache::KeyHash::operator()(const Key& key) const {
+    uint64_t rate_bits;
+    std::memcpy(&rate_bits, &key.sample_rate, sizeof(rate_bits));
+    return static_cast<size_t>(key.content ^ (rate_bits * 0x9E3779B97F4A7C15ULL));
+}
+
+const BeatGrid& AnalysisCache::analyze(const WaveformBuffer& waveform, double sample_rate) {
+    if (waveform.empty() || !BeatTracker::can_analyze(sample_rate)) {
+        return undetected;
+    }
+    Key key = {waveform.content_hash(), sample_rate};
+    Entry* entry;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        entry = &entries[key];     // node-based: the address survives rehashing
+    }
+    std::call_once(entry->analyzed, [this, entry, &waveform, sample_rate]() {
+        BeatTracker tracker(sample_rate);
+        entry->grid = tracker.analyze(waveform);
+        runs.fetch_add(1, std::memory_order_relaxed);
+        DJ_LOG(Debug, Track) << "[BeatTracker] " << waveform.size() << " samples at " << sample_rate
+                             << " Hz: " << entry->grid.bpm << " BPM, first beat " << entry->grid.first_beat
+                             << " s, confidence " << entry->grid.confidence << "\n";
+    });
+    return entry->grid;
+}
+
+size_t AnalysisCache::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
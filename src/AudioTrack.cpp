@@ -1,30 +1,25 @@
 #include "AudioTrack.h"
-#include <iostream>
+#include "AnalysisCache.h"
+#include "Logger.h"
 #include <cstring>
-#include <random>
+#include <iomanip>
+#include <sstream>
 
 AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
                       int duration, int bpm, size_t waveform_samples)
     : title(title), artists(artists), duration_seconds(duration), bpm(bpm), 
-      waveform_data(nullptr), waveform_size(waveform_samples) {
+      waveform(WaveformBuffer::synthesized(waveform_samples,
+                                           waveform_seed(title, artists, duration, bpm))),
+      analysis() {
 
-    // Allocate memory for waveform analysis
-    waveform_data = new double[waveform_size];
-
-    // Generate some dummy waveform data for testing
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dis(-1.0, 1.0);
-
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = dis(gen);
-    }
+    // Dummy waveform data for testing is generated on first access,
+    // reproducibly from the track identity.
     #ifdef DEBUG
-    std::cout << "AudioTrack created: " << title << " by " << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack created: " << title << " by " << std::endl;
     for (const auto& artist : artists) {
-        std::cout << artist << " ";
+        DJ_LOG(Debug, Track) << artist << " ";
     }
-    std::cout << std::endl;
+    DJ_LOG(Debug, Track) << std::endl;
     #endif
 }
 
@@ -33,71 +28,53 @@ AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>&
 AudioTrack::~AudioTrack() {
     // TODO: Implement the destructor
     #ifdef DEBUG
-    std::cout << "AudioTrack destructor called for: " << title << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack destructor called for: " << title << std::endl;
     #endif
     
-    // free allocated memory from the heap that was allocated by constructor
-    // and set pointer to null
-    delete[] waveform_data;
-    waveform_data = nullptr;}
+    // The waveform buffer drops its reference; the samples are freed
+    // when the last track sharing them is destroyed.
+}
 
 AudioTrack::AudioTrack(const AudioTrack& other):title(other.title), artists(other.artists), duration_seconds(other.duration_seconds), bpm(other.bpm), 
-      waveform_data(nullptr), waveform_size(other.waveform_size) 
+      waveform(other.waveform), analysis(other.analysis)
 {
     // TODO: Implement the copy constructor
     #ifdef DEBUG
-    std::cout << "AudioTrack copy constructor called for: " << other.title << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack copy constructor called for: " << other.title << std::endl;
     #endif
-    // Deep Copy: Allocate new memory for waveform_data.
-    waveform_data = new double[waveform_size]; 
-    
-    // Copy content element-by-element from the source to the new block.
-    // Prevents double-delete error.
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = other.waveform_data[i];
-    }
+    // Copy-on-write: the samples are shared with 'other' in O(1).
+    // A private copy is made only if one of the tracks modifies them.
 }
 
 AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
     // TODO: Implement the copy assignment operator
     #ifdef DEBUG
-    std::cout << "AudioTrack copy assignment called for: " << other.title << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack copy assignment called for: " << other.title << std::endl;
     #endif
 
     // Check for self-assignment
-    // CRITICAL: Skip cleanup if true to prevent crashing.
     if (this == &other) {
         return *this;
     }
 
-    // Clean up current object's old heap resource.
-    // Prevents a memory leak.
-    delete[] waveform_data; 
-
     // Shallow copy simple members.
     title = other.title;
     artists = other.artists;
     duration_seconds = other.duration_seconds;
     bpm = other.bpm;
-    waveform_size = other.waveform_size;
 
-    // Deep Copy: Allocate new memory for waveform_data.
-    waveform_data = new double[waveform_size]; 
-    
-    // Copy content element-by-element from the source to the new block.
-    // Prevents double-delete error.
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = other.waveform_data[i];
-    }    
+    // Share the waveform; our previous samples are released by the buffer.
+    waveform = other.waveform;
+    analysis = other.analysis;
     
     // Return reference to allow assignment chaining.
     return *this;
 }
 
 AudioTrack::AudioTrack(AudioTrack&& other) noexcept :title(std::move(other.title)), artists(std::move(other.artists)), duration_seconds(other.duration_seconds), bpm(other.bpm), 
-      waveform_data(nullptr), waveform_size(0){
+      waveform(std::move(other.waveform)), analysis(std::move(other.analysis)){
     #ifdef DEBUG
-    std::cout << "AudioTrack move constructor called for: " << other.title << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack move constructor called for: " << other.title << std::endl;
     #endif
 }
 
@@ -105,7 +82,7 @@ AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
     // TODO: Implement the move assignment operator
 
     #ifdef DEBUG
-    std::cout << "AudioTrack move assignment called for: " << other.title << std::endl;
+    DJ_LOG(Debug, Track) << "AudioTrack move assignment called for: " << other.title << std::endl;
     #endif
 
     // Check for self-assignment
@@ -114,11 +91,6 @@ AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
         return *this;
     }
 
-    // Clean up current object's old heap resource.
-    // Prevents a memory leak.
-    delete[] waveform_data; 
-
-
     // use std::move for non primitive types.
     // This calls the string/vector MOVE ASSIGNMENT operators, avoiding deep copies.
     title = std::move(other.title);
@@ -127,26 +99,78 @@ AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
     // For primitive type shallow copy.
     duration_seconds = other.duration_seconds;
     bpm = other.bpm;
-    waveform_size = other.waveform_size;
 
-    // Move ownership: Steal the raw pointer.
-    waveform_data = other.waveform_data;
-
-    // Nullify the source pointer.
-    // This leaves 'other' in a valid, destructible state (prevents double-delete).
-    other.waveform_data = nullptr;
-    other.waveform_size = 0; // Set size to 0 for clarity/safety
+    // Move ownership: steal the waveform reference, leaving 'other' empty.
+    waveform = std::move(other.waveform);
+    analysis = std::move(other.analysis);
     return *this;
 }
 
 void AudioTrack::get_waveform_copy(double* buffer, size_t buffer_size) const {
-    if (buffer && waveform_data && buffer_size <= waveform_size) {
-        std::memcpy(buffer, waveform_data, buffer_size * sizeof(double));
+    if (buffer && waveform.data() && buffer_size <= waveform.size()) {
+        std::memcpy(buffer, waveform.data(), buffer_size * sizeof(double));
     }
 }
 
+const BeatGrid& AudioTrack::get_beatgrid() const {
+    if (analysis) {
+        return *analysis->beatgrid;
+    }
+    double sample_rate = duration_seconds > 0 ? static_cast<double>(waveform.size()) / duration_seconds : 0.0;
+    return AnalysisCache::instance().analyze(waveform, sample_rate);
+}
+
+std::string AudioTrack::describe_beatgrid() const {
+    const BeatGrid& grid = get_beatgrid();
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1);
+    if (grid.detected()) {
+        line << "Tracked grid: " << grid.bpm << " BPM, " << grid.beats << " beats, confidence "
+             << std::setprecision(2) << grid.confidence;
+        return line.str();
+    }
+    double sample_rate = duration_seconds > 0 ? static_cast<double>(waveform.size()) / duration_seconds : 0.0;
+    if (!BeatTracker::can_analyze(sample_rate)) {
+        line << "Beat grid unavailable: waveform at " << sample_rate << " Hz is too coarse to track";
+    } else {
+        line << "Beat grid not detected";
+    }
+    return line.str();
+}
+
+size_t AudioTrack::get_memory_footprint() const {
+    size_t bytes = sizeof(AudioTrack);
+    bytes += title.capacity();
+    bytes += artists.capacity() * sizeof(std::string);
+    for (const auto& artist : artists) {
+        bytes += artist.capacity();
+    }
+    bytes += waveform.size() * sizeof(double);
+    return bytes;
+}
+
 // ========== Helper Functions ===========
 
 void AudioTrack::set_bpm(int new_bpm) {
     bpm = new_bpm;
+}
+
+uint64_t AudioTrack::waveform_seed(const std::string& title, const std::vector<std::string>& artists,
+                                   int duration, int bpm) {
+    // FNV-1a over the identity fields
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const std::string& text) {
+        for (size_t i = 0; i < text.size(); ++i) {
+            hash ^= static_cast<unsigned char>(text[i]);
+            hash *= 1099511628211ULL;
+        }
+        hash *= 1099511628211ULL;  // '\0' terminator
+    };
+    mix(title);
+    for (const auto& artist : artists) {
+        mix(artist);
+    }
+    hash ^= static_cast<uint64_t>(static_cast<uint32_t>(duration)) << 32 | static_cast<uint32_t>(bpm);
+    hash *= 1099511628211ULL;
+    return hash;
 }
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "BeatTracker.h"
+#include "WaveformBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr double BeatTracker::MIN_BPM;
+constexpr double BeatTracker::MAX_BPM;
+constexpr double BeatTracker::PRIOR_BPM;
+const size_t BeatTracker::MIN_FRAME;
+
+namespace {
+
+const double FRAMES_PER_SECOND = 50.0;   // onset frames are about 20 ms long
+const double COMPRESSION = 10.0;         // log(1 + COMPRESSION * |X|) before the flux
+const double MEAN_SECONDS = 0.1;         // half-width of the local mean removed from the flux
+const double PRIOR_OCTAVES = 1.0;        // width of the tempo prior
+const double SUBHARMONIC_RATIO = 0.8;    // relative strength at half the lag that halves the period
+const double SMOOTH_SECONDS = 0.02;      // half-width of the envelope smoothing before autocorrelation
+
+size_t frame_for(double sample_rate) {
+    if (!(sample_rate > 0.0) || sample_rate > 1e9) {
+        return 0;
+    }
+    size_t wanted = static_cast<size_t>(std::ceil(sample_rate / FRAMES_PER_SECOND));
+    size_t frame = 1;
+    while (frame < wanted) {
+        frame *= 2;
+    }
+    return frame;
+}
+
+}  // namespace
+
+BeatTracker::BeatTracker(double sample_rate)
+    : sample_rate(sample_rate), frame(frame_for(sample_rate)), hop(frame / 2),
+      window(), twiddle_re(), twiddle_im(), input(), real(), imag(), magnitude(), onsets() {
+    if (!can_analyze(sample_rate)) {
+        frame = 0;
+        hop = 0;
+        return;
+    }
+    window.resize(frame);
+    const double pi = std::acos(-1.0);
+    for (size_t n = 0; n < frame; ++n) {
+        window[n] = 0.5 - 0.5 * std::cos(2.0 * pi * n / frame);
+    }
+    twiddle_re.resize(frame / 2);
+    twiddle_im.resize(frame / 2);
+    for (size_t k = 0; k < frame / 2; ++k) {
+        twiddle_re[k] = std::cos(2.0 * pi * k / frame);
+        twiddle_im[k] = -std::sin(2.0 * pi * k / frame);
+    }
+    input.resize(frame);
+    real.resize(frame / 2);
+    imag.resize(frame / 2);
+    magnitude.resize(frame / 2 + 1);
+}
+
+bool BeatTracker::can_analyze(double sample_rate) {
+    return frame_for(sample_rate) >= MIN_FRAME;
+}
+
+BeatGrid BeatTracker::analyze(const WaveformBuffer& waveform) {
+    BeatGrid grid;
+    onsets.clear();
+    if (frame == 0) {
+        return grid;
+    }
+    onset_envelope(waveform);
+
+    double period = estimate_period(grid.confidence);
+    if (period <= 0.0) {
+        grid.confidence = 0.0;
+        return grid;
+    }
+    double phase = estimate_phase(period);
+    fit_grid(period, phase);
+    const double envelope_rate = sample_rate / hop;
+    const double beat_seconds = period / envelope_rate;
+    const double resolution = 0.5 * frame / sample_rate;
+
+    // Onset frame m is centered on sample m * hop + frame / 2; beats before
+    // the first full frame are found by stepping back whole periods
+    double first = (phase * hop + frame / 2) / sample_rate;
+    first -= std::floor((first + resolution) / beat_seconds) * beat_seconds;
+
+    const double duration = waveform.size() / sample_rate;
+    grid.bpm = 60.0 / beat_seconds;
+    grid.first_beat = std::max(first, 0.0);
+    grid.beats = grid.first_beat < duration
+                     ? static_cast<size_t>((duration - grid.first_beat) / beat_seconds) + 1
+                     : 0;
+    return grid;
+}
+
+void BeatTracker::onset_envelope(const WaveformBuffer& waveform) {
+    const size_t count = waveform.size();
+    if (count < frame) {
+        return;
+    }
+    const size_t frames = (count - frame) / hop + 1;
+    const size_t half = frame / 2;
+    std::vector<double> flux(frames, 0.0);
+    for (size_t m = 0; m < frames; ++m) {
+        // Real input as a half-size complex FFT: even samples in real, odd in imag
+        waveform.read(m * hop, input.data(), frame);
+        for (size_t n = 0; n < half; ++n) {
+            real[n] = input[2 * n] * window[2 * n];
+            imag[n] = input[2 * n + 1] * window[2 * n + 1];
+        }
+        fft();
+        double sum = 0.0;
+        for (size_t k = 0; k <= half; ++k) {
+            // Split Z[k] and conj(Z[half - k]) into the spectra of the even
+            // and odd samples, then X[k] = even + e^(-2 pi i k / frame) * odd
+            const size_t a = k < half ? k : 0;
+            const size_t b = k > 0 ? half - k : 0;
+            const double even_re = 0.5 * (real[a] + real[b]);
+            const double even_im = 0.5 * (imag[a] - imag[b]);
+            const double odd_re = 0.5 * (imag[a] + imag[b]);
+            const double odd_im = -0.5 * (real[a] - real[b]);
+            const double w_re = k < half ? twiddle_re[k] : -1.0;
+            const double w_im = k < half ? twiddle_im[k] : 0.0;
+            const double x_re = even_re + w_re * odd_re - w_im * odd_im;
+            const double x_im = even_im + w_re * odd_im + w_im * odd_re;
+            const double level = std::log1p(COMPRESSION * std::sqrt(x_re * x_re + x_im * x_im));
+            if (m > 0 && level > magnitude[k]) {
+                sum += level - magnitude[k];
+            }
+            magnitude[k] = level;
+        }
+        flux[m] = sum;
+    }
+
+    // Keep what rises above the local mean, so steady texture does not count as onsets
+    const size_t reach = std::max<size_t>(1, static_cast<size_t>(MEAN_SECONDS * sample_rate / hop));
+    std::vector<double> prefix(frames + 1, 0.0);
+    for (size_t m = 0; m < frames; ++m) {
+        prefix[m + 1] = prefix[m] + flux[m];
+    }
+    onsets.resize(frames);
+    for (size_t m = 0; m < frames; ++m) {
+        size_t low = m > reach ? m - reach : 0;
+        size_t high = std::min(frames, m + reach + 1);
+        double mean = (prefix[high] - prefix[low]) / (high - low);
+        onsets[m] = std::max(0.0, flux[m] - mean);
+    }
+}
+
+void BeatTracker::fft() {
+    // Iterative radix-2, in place on real/imag; size is a power of two
+    const size_t size = frame / 2;
+    for (size_t i = 1, j = 0; i < size; ++i) {
+        size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+    for (size_t length = 2; length <= size; length *= 2) {
+        const size_t stride = frame / length;     // twiddle k of this stage is table entry k * stride
+        for (size_t start = 0; start < size; start += length) {
+            for (size_t k = 0; k < length / 2; ++k) {
+                const size_t a = start + k;
+                const size_t b = a + length / 2;
+                const double w_re = twiddle_re[k * stride];
+                const double w_im = twiddle_im[k * stride];
+                const double t_re = real[b] * w_re - imag[b] * w_im;
+                const double t_im = real[b] * w_im + imag[b] * w_re;
+                real[b] = real[a] - t_re;
+                imag[b] = imag[a] - t_im;
+                real[a] += t_re;
+                imag[a] += t_im;
+            }
+        }
+    }
+}
+
+double BeatTracker::estimate_period(double& confidence) const {
+    confidence = 0.0;
+    const double envelope_rate = sample_rate / hop;
+    const size_t min_lag = static_cast<size_t>(std::floor(envelope_rate * 60.0 / MAX_BPM));
+    const size_t max_lag = static_cast<size_t>(std::ceil(envelope_rate * 60.0 / MIN_BPM));
+    const size_t n = onsets.size();
+    // Need the lags around the peak for refinement, and two periods of the slowest tempo
+    if (min_lag < 2 || n < 2 * (max_lag + 1)) {
+        return 0.0;
+    }
+
+    // Onsets are about one frame wide; smoothing them keeps the
+    // autocorrelation peak from splitting when the period is not a whole
+    // number of frames (which would favour a multiple of the period)
+    const size_t half = std::max<size_t>(1, static_cast<size_t>(SMOOTH_SECONDS * envelope_rate + 0.5));
+    std::vector<double> smooth(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        double weights = 0.0;
+        for (size_t j = (i > half ? i - half : 0); j <= std::min(n - 1, i + half); ++j) {
+            double weight = static_cast<double>(half + 1) - std::fabs(static_cast<double>(j) - static_cast<double>(i));
+            sum += weight * onsets[j];
+            weights += weight;
+        }
+        smooth[i] = sum / weights;
+    }
+
+    std::vector<double> acf(max_lag + 2, 0.0);
+    double energy = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        energy += smooth[i] * smooth[i];
+    }
+    if (energy <= 0.0) {
+        return 0.0;
+    }
+    energy /= n;
+    for (size_t lag = min_lag - 1; lag <= max_lag + 1; ++lag) {
+        double sum = 0.0;
+        for (size_t i = 0; i + lag < n; ++i) {
+            sum += smooth[i] * smooth[i + lag];
+        }
+        acf[lag] = sum / (n - lag);
+    }
+
+    size_t best = 0;
+    double best_score = 0.0;
+    for (size_t lag = min_lag; lag <= max_lag; ++lag) {
+        double octaves = std::log2(envelope_rate * 60.0 / lag / PRIOR_BPM) / PRIOR_OCTAVES;
+        double score = acf[lag] * std::exp(-0.5 * octaves * octaves);
+        if (score > best_score) {
+            best_score = score;
+            best = lag;
+        }
+    }
+    if (best == 0) {
+        return 0.0;
+    }
+    // Onsets on every beat correlate at every multiple of the period too, so
+    // a peak about as strong at half the lag means best is a multiple
+    while (best / 2 >= min_lag) {
+        size_t half_lag = best / 2;
+        for (size_t lag = std::max(min_lag, best / 2 - 1); lag <= (best + 1) / 2 + 1; ++lag) {
+            if (acf[lag] > acf[half_lag]) {
+                half_lag = lag;
+            }
+        }
+        if (acf[half_lag] < SUBHARMONIC_RATIO * acf[best]) {
+            break;
+        }
+        best = half_lag;
+    }
+
+    double period = static_cast<double>(best);
+    const double before = acf[best - 1];
+    const double peak = acf[best];
+    const double after = acf[best + 1];
+    const double curvature = before - 2.0 * peak + after;
+    if (curvature < 0.0) {
+        period += std::max(-0.5, std::min(0.5, 0.5 * (before - after) / curvature));
+    }
+    confidence = std::min(1.0, peak / energy);
+    return period;
+}
+
+double BeatTracker::estimate_phase(double period) const {
+    const size_t n = onsets.size();
+    const size_t phases = static_cast<size_t>(std::ceil(period));
+    size_t best = 0;
+    double best_score = -1.0;
+    for (size_t phase = 0; phase < phases; ++phase) {
+        double sum = 0.0;
+        size_t count = 0;
+        for (double position = static_cast<double>(phase); position + 0.5 < n; position += period) {
+            sum += onsets[static_cast<size_t>(position + 0.5)];
+            ++count;
+        }
+        double score = count ? sum / count : 0.0;
+        if (score > best_score) {
+            best_score = score;
+            best = phase;
+        }
+    }
+    return static_cast<double>(best);
+}
+
+void BeatTracker::fit_grid(double& period, double& phase) const {
+    const size_t n = onsets.size();
+    double mean = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        mean += onsets[i];
+    }
+    mean /= n;
+
+    // Two passes: the second searches around the beats the first fit predicts
+    for (int pass = 0; pass < 2; ++pass) {
+        double weights = 0.0, sum_k = 0.0, sum_kk = 0.0, sum_x = 0.0, sum_kx = 0.0;
+        for (size_t k = 0; phase + k * period < n; ++k) {
+            const double predicted = phase + k * period;
+            const size_t low = static_cast<size_t>(std::max(0.0, std::ceil(predicted - period / 4)));
+            const size_t high = std::min(n - 1, static_cast<size_t>(std::floor(predicted + period / 4)));
+            size_t peak = low;
+            for (size_t m = low; m <= high; ++m) {
+                if (onsets[m] > onsets[peak]) {
+                    peak = m;
+                }
+            }
+            if (low > high || onsets[peak] <= mean) {
+                continue;     // no onset near this beat
+            }
+            double x = static_cast<double>(peak);
+            if (peak > 0 && peak + 1 < n) {
+                const double curvature = onsets[peak - 1] - 2.0 * onsets[peak] + onsets[peak + 1];
+                if (curvature < 0.0) {
+                    x += std::max(-0.5, std::min(0.5, 0.5 * (onsets[peak - 1] - onsets[peak + 1]) / curvature));
+                }
+            }
+            const double weight = onsets[peak];
+            weights += weight;
+            sum_k += weight * k;
+            sum_kk += weight * k * k;
+            sum_x += weight * x;
+            sum_kx += weight * k * x;
+        }
+        const double determinant = weights * sum_kk - sum_k * sum_k;
+        if (!(determinant > 0.0)) {
+            return;       // fewer than two beats found: keep the estimate
+        }
+        const double fitted = (weights * sum_kx - sum_k * sum_x) / determinant;
+        if (!(fitted > period * 0.9 && fitted < period * 1.1)) {
+            return;
+        }
+        period = fitted;
+        phase = (sum_x - period * sum_k) / weights;
+    }
+}
@@ -0,0 +1,74 @@
+#include "BeladyPolicy.h"
+#include "PolicyLists.h"
+#include <algorithm>
+#include <functional>
+
+BeladyPolicy::BeladyPolicy(const PlaybackSchedule* schedule, size_t capacity)
+    : schedule(schedule), keys(), resident(), resident_pos() {
+    reset(capacity);
+}
+
+void BeladyPolicy::reset(size_t capacity) {
+    keys.assign(capacity, 0);
+    resident.clear();
+    resident_pos.assign(capacity, SlotList::NONE);
+}
+
+void BeladyPolicy::onInsert(size_t slot, const std::string& key) {
+    if (slot >= keys.size()) {
+        keys.resize(slot + 1, 0);
+        resident_pos.resize(slot + 1, SlotList::NONE);
+    }
+    keys[slot] = policy_key_hash(key);
+    if (resident_pos[slot] == SlotList::NONE) {
+        resident_pos[slot] = resident.size();
+        resident.push_back(slot);
+    }
+}
+
+void BeladyPolicy::onAccess(size_t slot) {
+    (void)slot;  // recency is irrelevant, only the future order matters
+}
+
+void BeladyPolicy::onRemove(size_t slot) {
+    if (slot >= resident_pos.size() || resident_pos[slot] == SlotList::NONE) return;
+    // Swap-remove from the resident set
+    size_t pos = resident_pos[slot];
+    size_t last = resident.back();
+    resident[pos] = last;
+    resident_pos[last] = pos;
+    resident.pop_back();
+    resident_pos[slot] = SlotList::NONE;
+}
+
+size_t BeladyPolicy::furthestSlot() const {
+    size_t best_slot = SlotList::NONE;
+    size_t best_use = 0;
+    for (size_t i = 0; i < resident.size(); ++i) {
+        size_t next_use = schedule ? schedule->nextUseOfHash(keys[resident[i]])
+                                   : PlaybackSchedule::NEVER;
+        if (best_slot == SlotList::NONE || next_use > best_use) {
+            best_slot = resident[i];
+            best_use = next_use;
+            if (best_use == PlaybackSchedule::NEVER) break;
+        }
+    }
+    return best_slot;
+}
+
+size_t BeladyPolicy::selectVictim(const std::string& incoming) {
+    (void)incoming;
+    return furthestSlot();
+}
+
+std::vector<std::pair<size_t, size_t> > BeladyPolicy::evictionOrder() const {
+    std::vector<std::pair<size_t, size_t> > order;
+    order.reserve(resident.size());
+    for (size_t i = 0; i < resident.size(); ++i) {
+        size_t next_use = schedule ? schedule->nextUseOfHash(keys[resident[i]])
+                                   : PlaybackSchedule::NEVER;
+        order.push_back(std::make_pair(next_use, resident[i]));
+    }
+    std::sort(order.begin(), order.end(), std::greater<std::pair<size_t, size_t> >());
+    return order;
+}
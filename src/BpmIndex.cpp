@@ -0,0 +1,156 @@
+#include "BpmIndex.h"
+#include <algorithm>
+#include <utility>
+
+const int BpmIndex::MIN_BPM;
+const int BpmIndex::MAX_BPM;
+const size_t BpmIndex::BUCKETS;
+const size_t BpmIndex::KINDS;
+
+BpmIndex::BpmIndex() : kinds(), indexed(0), skipped(0) {}
+
+void BpmIndex::clear() {
+    for (KindBuckets& buckets : kinds) {
+        std::fill(buckets.start.begin(), buckets.start.end(), 0);
+        buckets.quality.clear();
+        buckets.ids.clear();
+    }
+    indexed = 0;
+    skipped = 0;
+}
+
+void BpmIndex::build(const std::vector<Entry>& entries) {
+    clear();
+
+    // Counting sort into buckets: count, prefix-sum, place
+    for (const Entry& entry : entries) {
+        if (entry.bpm < MIN_BPM || entry.bpm > MAX_BPM || entry.kind == TrackKind::Any) {
+            ++skipped;
+            continue;
+        }
+        ++kinds[static_cast<size_t>(entry.kind)].start[entry.bpm - MIN_BPM + 1];
+        ++indexed;
+    }
+
+    typedef std::pair<float, uint32_t> Ranked;   // quality, library index
+    for (size_t k = 0; k < KINDS; ++k) {
+        KindBuckets& buckets = kinds[k];
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            buckets.start[b + 1] += buckets.start[b];
+        }
+
+        std::vector<Ranked> ranked(buckets.start[BUCKETS]);
+        std::vector<uint32_t> fill(buckets.start.begin(), buckets.start.end() - 1);
+        for (const Entry& entry : entries) {
+            if (static_cast<size_t>(entry.kind) != k || entry.bpm < MIN_BPM || entry.bpm > MAX_BPM) {
+                continue;
+            }
+            ranked[fill[entry.bpm - MIN_BPM]++] = Ranked(entry.quality, entry.library_index);
+        }
+
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            std::sort(ranked.begin() + buckets.start[b], ranked.begin() + buckets.start[b + 1],
+                      [](const Ranked& a, const Ranked& c) {
+                          return a.first != c.first ? a.first > c.first : a.second < c.second;
+                      });
+        }
+
+        buckets.quality.resize(ranked.size());
+        buckets.ids.resize(ranked.size());
+        for (size_t i = 0; i < ranked.size(); ++i) {
+            buckets.quality[i] = ranked[i].first;
+            buckets.ids[i] = ranked[i].second;
+        }
+    }
+}
+
+size_t BpmIndex::count(int min_bpm, int max_bpm) const {
+    min_bpm = std::max(min_bpm, MIN_BPM);
+    max_bpm = std::min(max_bpm, MAX_BPM);
+    if (min_bpm > max_bpm) {
+        return 0;
+    }
+    size_t total = 0;
+    for (const KindBuckets& buckets : kinds) {
+        total += buckets.start[max_bpm - MIN_BPM + 1] - buckets.start[min_bpm - MIN_BPM];
+    }
+    return total;
+}
+
+size_t BpmIndex::take_bucket(size_t bucket, const Filter& filter, size_t limit,
+                             std::vector<uint32_t>& out) const {
+    // Buckets are sorted by quality descending: the filter keeps a prefix
+    const double min_quality = filter.min_quality;
+    size_t begin[KINDS];
+    size_t end[KINDS];
+    for (size_t k = 0; k < KINDS; ++k) {
+        const KindBuckets& buckets = kinds[k];
+        begin[k] = buckets.start[bucket];
+        end[k] = begin[k];
+        if (filter.kind != TrackKind::Any && static_cast<size_t>(filter.kind) != k) {
+            continue;
+        }
+        end[k] = std::partition_point(buckets.quality.begin() + buckets.start[bucket],
+                                      buckets.quality.begin() + buckets.start[bucket + 1],
+                                      [min_quality](float quality) { return quality >= min_quality; })
+                 - buckets.quality.begin();
+    }
+
+    // Merge the kinds by quality (ties by library index), as one bucket would order them
+    size_t taken = 0;
+    while (taken < limit) {
+        const KindBuckets& mp3 = kinds[0];
+        const KindBuckets& wav = kinds[1];
+        bool has_mp3 = begin[0] < end[0];
+        bool has_wav = begin[1] < end[1];
+        if (!has_mp3 && !has_wav) {
+            break;
+        }
+        bool pick_mp3 = has_mp3 &&
+            (!has_wav || mp3.quality[begin[0]] > wav.quality[begin[1]] ||
+             (mp3.quality[begin[0]] == wav.quality[begin[1]] && mp3.ids[begin[0]] < wav.ids[begin[1]]));
+        if (pick_mp3) {
+            out.push_back(mp3.ids[begin[0]++]);
+        } else {
+            out.push_back(wav.ids[begin[1]++]);
+        }
+        ++taken;
+    }
+    return taken;
+}
+
+size_t BpmIndex::find_range(int min_bpm, int max_bpm, const Filter& filter, size_t limit,
+                            std::vector<uint32_t>& out) const {
+    min_bpm = std::max(min_bpm, MIN_BPM);
+    max_bpm = std::min(max_bpm, MAX_BPM);
+    size_t found = 0;
+    for (int bpm = min_bpm; bpm <= max_bpm && found < limit; ++bpm) {
+        found += take_bucket(static_cast<size_t>(bpm - MIN_BPM), filter, limit - found, out);
+    }
+    return found;
+}
+
+size_t BpmIndex::find_nearest(int bpm, size_t k, int max_distance, const Filter& filter,
+                              std::vector<uint32_t>& out) const {
+    // Distances in long long: bpm and max_distance may be anywhere in int range
+    const long long target = bpm;
+    long long distance = 0;
+    if (target < MIN_BPM) distance = MIN_BPM - target;
+    if (target > MAX_BPM) distance = target - MAX_BPM;
+
+    size_t found = 0;
+    for (; distance <= max_distance && found < k; ++distance) {
+        long long lower = target - distance;
+        long long upper = target + distance;
+        if (lower < MIN_BPM && upper > MAX_BPM) {
+            break;
+        }
+        if (lower >= MIN_BPM && lower <= MAX_BPM) {
+            found += take_bucket(static_cast<size_t>(lower - MIN_BPM), filter, k - found, out);
+        }
+        if (distance > 0 && upper >= MIN_BPM && upper <= MAX_BPM && found < k) {
+            found += take_bucket(static_cast<size_t>(upper - MIN_BPM), filter, k - found, out);
+        }
+    }
+    return found;
+}
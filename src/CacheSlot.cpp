@@ -1,14 +1,20 @@
 #include "CacheSlot.h"
 
+const size_t CacheSlot::NO_SLOT;
+
 CacheSlot::CacheSlot() : 
-    track(nullptr), 
+    track(), 
     last_access_time(0), 
-    occupied(false){
+    bytes(0),
+    occupied(false),
+    prev(NO_SLOT),
+    next(NO_SLOT){
 }
 
-void CacheSlot::store(PointerWrapper<AudioTrack> track_ptr, uint64_t access_time) {
-    track = std::move(track_ptr);
+void CacheSlot::store(const TrackHandle& track_ptr, uint64_t access_time) {
+    track = track_ptr;
     last_access_time = access_time;
+    bytes = track ? track->get_memory_footprint() : 0;
     occupied = true;
 }
 
@@ -22,7 +28,10 @@ AudioTrack* CacheSlot::access(uint64_t access_time) {
 }
 
 void CacheSlot::clear() {
-    track.reset(nullptr);
+    track.reset();
     occupied = false;
     last_access_time = 0;
+    bytes = 0;
+    prev = NO_SLOT;
+    next = NO_SLOT;
 }
\ No newline at end of file
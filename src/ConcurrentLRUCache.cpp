@@ -0,0 +1,227 @@
+#include "ConcurrentLRUCache.h"
+#include "Logger.h"
+#include <algorithm>
+
+ConcurrentLRUCache::ConcurrentLRUCache(size_t capacity, size_t shard_count)
+    : shards(), max_size(capacity), max_bytes(0), requested_shards(1) {
+    set_shard_count(shard_count);
+}
+
+size_t ConcurrentLRUCache::shareOf(size_t total, size_t shard, size_t count) {
+    return total / count + (shard < total % count ? 1 : 0);
+}
+
+size_t ConcurrentLRUCache::shardOf(const std::string& track_id) const {
+    if (shards.size() == 1) return 0;
+    // Mix the high bits in so similar titles spread across shards
+    uint64_t hash = policy_key_hash(track_id);
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash % shards.size());
+}
+
+bool ConcurrentLRUCache::contains(const std::string& track_id) const {
+    const Shard& shard = *shards[shardOf(track_id)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.contains(track_id);
+}
+
+AudioTrack* ConcurrentLRUCache::get(const std::string& track_id) {
+    Shard& shard = *shards[shardOf(track_id)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.get(track_id);
+}
+
+bool ConcurrentLRUCache::put(const TrackHandle& track) {
+    if (!track) {
+        return false;
+    }
+    Shard& shard = *shards[shardOf(track->get_title())];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.put(track);
+}
+
+bool ConcurrentLRUCache::put(PointerWrapper<AudioTrack> track) {
+    return put(TrackHandle(track.release()));
+}
+
+bool ConcurrentLRUCache::Shard::isPending(const std::string& title) const {
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (*pending[i] == title) return true;
+    }
+    return false;
+}
+
+void ConcurrentLRUCache::Shard::settle(const std::string& title) {
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (*pending[i] == title) {
+            pending[i] = pending.back();
+            pending.pop_back();
+            break;
+        }
+    }
+    if (waiting) prepared.notify_all();
+}
+
+ConcurrentLRUCache::Lookup ConcurrentLRUCache::get_or_insert(
+        const TrackHandle& track, const std::function<void(AudioTrack&)>& prepare) {
+    const std::string& title = track->get_title();
+    Shard& shard = *shards[shardOf(title)];
+    std::unique_lock<std::mutex> guard(shard.lock);
+    // Another thread preparing the same title inserts it (or gives up) before we look again
+    while (!shard.cache.get(title)) {
+        if (!shard.isPending(title)) {
+            break;
+        }
+        ++shard.waiting;
+        shard.prepared.wait(guard);
+        --shard.waiting;
+    }
+    if (shard.cache.contains(title)) {
+        return Lookup::Hit;
+    }
+    if (!shard.cache.canFit(track->get_memory_footprint())) {
+        return Lookup::TooLarge;
+    }
+
+    shard.pending.push_back(&title);
+    guard.unlock();
+    try {
+        prepare(*track);
+    } catch (...) {
+        guard.lock();
+        shard.settle(title);
+        throw;
+    }
+    guard.lock();
+    bool evicted = shard.cache.put(track);
+    shard.settle(title);
+    return evicted ? Lookup::InsertedWithEviction : Lookup::Inserted;
+}
+
+bool ConcurrentLRUCache::canFit(const std::string& track_id, size_t bytes) const {
+    const Shard& shard = *shards[shardOf(track_id)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.canFit(bytes);
+}
+
+bool ConcurrentLRUCache::evictLRU() {
+    // Per-shard access counters are not comparable, so take from the fullest shard
+    size_t fullest = 0;
+    size_t fullest_size = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        if (shards[i]->cache.size() > fullest_size) {
+            fullest = i;
+            fullest_size = shards[i]->cache.size();
+        }
+    }
+    if (fullest_size == 0) return false;
+    std::lock_guard<std::mutex> guard(shards[fullest]->lock);
+    return shards[fullest]->cache.evictLRU();
+}
+
+size_t ConcurrentLRUCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        total += shards[i]->cache.size();
+    }
+    return total;
+}
+
+bool ConcurrentLRUCache::isFull() const {
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (!shardIsFull(i)) return false;
+    }
+    return true;
+}
+
+void ConcurrentLRUCache::clear() {
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        shards[i]->cache.clear();
+    }
+}
+
+void ConcurrentLRUCache::displayStatus() const {
+    if (shards.size() == 1) {
+        std::lock_guard<std::mutex> guard(shards[0]->lock);
+        shards[0]->cache.displayStatus();
+        return;
+    }
+    DJ_LOG(Info, Cache) << "[ConcurrentLRUCache] " << shards.size() << " shards, "
+              << size() << "/" << max_size << " slots used\n";
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        DJ_LOG(Info, Cache) << "--- Shard " << i << " ---\n";
+        shards[i]->cache.displayStatus();
+    }
+}
+
+void ConcurrentLRUCache::set_capacity(size_t capacity) {
+    max_size = capacity;
+    size_t count = usableShards();
+    if (count != shards.size()) {
+        reshard(count);
+        return;
+    }
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        shards[i]->cache.set_capacity(shareOf(capacity, i, shards.size()));
+    }
+}
+
+void ConcurrentLRUCache::set_byte_budget(size_t bytes) {
+    max_bytes = bytes;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        shards[i]->cache.set_byte_budget(bytes == 0 ? 0 : shareOf(bytes, i, shards.size()));
+    }
+}
+
+void ConcurrentLRUCache::set_shard_count(size_t shard_count) {
+    requested_shards = shard_count == 0 ? 1 : shard_count;
+    reshard(usableShards());
+}
+
+size_t ConcurrentLRUCache::usableShards() const {
+    // A shard with no slots could never cache the titles that hash to it
+    return max_size == 0 ? requested_shards : std::min(requested_shards, max_size);
+}
+
+void ConcurrentLRUCache::reshard(size_t count) {
+    if (count < requested_shards) {
+        DJ_LOG(Warn, Cache) << "[WARNING] " << requested_shards << " cache shards requested for "
+                  << max_size << " slots; using " << count << " shards\n";
+    }
+    shards.clear();
+    for (size_t i = 0; i < count; ++i) {
+        shards.push_back(PointerWrapper<Shard>(new Shard(shareOf(max_size, i, count))));
+    }
+    if (max_bytes != 0) set_byte_budget(max_bytes);
+}
+
+size_t ConcurrentLRUCache::shardCapacity(size_t shard) const {
+    std::lock_guard<std::mutex> guard(shards[shard]->lock);
+    return shards[shard]->cache.capacity();
+}
+
+bool ConcurrentLRUCache::shardIsFull(size_t shard) const {
+    std::lock_guard<std::mutex> guard(shards[shard]->lock);
+    return shards[shard]->cache.isFull();
+}
+
+void ConcurrentLRUCache::inspectShard(size_t shard, const std::function<void(const LRUCache&)>& inspect) const {
+    std::lock_guard<std::mutex> guard(shards[shard]->lock);
+    inspect(shards[shard]->cache);
+}
+
+void ConcurrentLRUCache::set_policy(size_t shard, PointerWrapper<EvictionPolicy> policy) {
+    std::lock_guard<std::mutex> guard(shards[shard]->lock);
+    shards[shard]->cache.set_policy(std::move(policy));
+}
+
+const char* ConcurrentLRUCache::policyName() const {
+    std::lock_guard<std::mutex> guard(shards[0]->lock);
+    return shards[0]->cache.policyName();
+}
@@ -1,7 +1,7 @@
 #include "ConfigurationManager.h"
+#include "Logger.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
 
 ConfigurationManager::ConfigurationManager() :
     cache_size(8),
@@ -12,7 +12,7 @@ ConfigurationManager::ConfigurationManager() :
 bool ConfigurationManager::loadFromFile(const std::string& config_path) {
     std::ifstream file(config_path);
     if (!file.is_open()) {
-        std::cerr << "[ERROR] Could not open config file: " << config_path << std::endl;
+        DJ_LOG_ERR(Error, Config) << "[ERROR] Could not open config file: " << config_path << std::endl;
         return false;
     }
     
@@ -54,16 +54,16 @@ std::string ConfigurationManager::getSetting(const std::string& key) const {
 }
 
 void ConfigurationManager::displayConfiguration() const {
-    std::cout << "=== DJ System Configuration ===" << std::endl;
-    std::cout << "Cache Size: " << cache_size << " slots" << std::endl;
-    std::cout << "BPM Tolerance: " << bpm_tolerance << " BPM" << std::endl;
-    std::cout << "Auto Sync: " << (auto_sync ? "enabled" : "disabled") << std::endl;
+    DJ_LOG(Info, Config) << "=== DJ System Configuration ===" << std::endl;
+    DJ_LOG(Info, Config) << "Cache Size: " << cache_size << " slots" << std::endl;
+    DJ_LOG(Info, Config) << "BPM Tolerance: " << bpm_tolerance << " BPM" << std::endl;
+    DJ_LOG(Info, Config) << "Auto Sync: " << (auto_sync ? "enabled" : "disabled") << std::endl;
     
     if (!additional_settings.empty()) {
-        std::cout << "Additional Settings:" << std::endl;
+        DJ_LOG(Info, Config) << "Additional Settings:" << std::endl;
         for (const auto& setting : additional_settings) {
-            std::cout << "  " << setting.first << ": " << setting.second << std::endl;
+            DJ_LOG(Info, Config) << "  " << setting.first << ": " << setting.second << std::endl;
         }
     }
-    std::cout << std::endl;
+    DJ_LOG(Info, Config) << std::endl;
 }
\ No newline at end of file
@@ -1,58 +1,99 @@
 #include "DJControllerService.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
-#include <iostream>
+#include "Logger.h"
 #include <memory>
 
 DJControllerService::DJControllerService(size_t cache_size)
-    : cache(cache_size) {}
+    : cache(cache_size), schedule(), belady(), lookahead(0) {}
 /**
  * TODO: Implement loadTrackToCache method
  */
-int DJControllerService::loadTrackToCache(AudioTrack& track) {
-    // (a) check if track with the same title is already in cache
-    if(cache.contains(track.get_title())){
-        // (b) HIT
-        cache.get(track.get_title()); // update LRU order
-        return 1;
+int DJControllerService::loadTrackToCache(const TrackHandle& track) {
+    if (!track) {
+        throw std::runtime_error("Attempted to dereference a null TrackHandle.");
     }
 
-    // (c) MISS - track not found 
-    // Create a polymorphic clone of the track
+    // (a) HIT updates the LRU order; (c) MISS simulates loading the track and
+    // does a beatgrid analysis, then inserts it (the cache shares the library's
+    // track). The title is marked pending while it is prepared outside the
+    // shard lock, so concurrent sessions missing on it prepare and insert it once.
+    switch (cache.get_or_insert(track, [](AudioTrack& missed) {
+        missed.load();
+        missed.analyze_beatgrid();
+    })) {
+    case ConcurrentLRUCache::Lookup::Hit:
+        return 1;                  // (b) HIT
+    case ConcurrentLRUCache::Lookup::InsertedWithEviction:
+        return -1;                 // (d) MISS with eviction
+    case ConcurrentLRUCache::Lookup::TooLarge:
+        return -2;                 // never loaded, never cached
+    case ConcurrentLRUCache::Lookup::Inserted:
+        break;
+    }
+    // (e) MISS without eviction
+    return 0;
+}
+
+int DJControllerService::loadTrackToCache(AudioTrack& track) {
+    if (cache.get(track.get_title())) {
+        return 1; // HIT: LRU order updated
+    }
+    // Create a polymorphic clone of the track for the cache to own; if another
+    // thread caches the title first, the clone is dropped and this is a HIT
     PointerWrapper<AudioTrack> track_clone = track.clone();
-    
-    // Check if pointer is null
     if(!track_clone){
         throw std::runtime_error("Attempted to dereference a null PointerWrapper.");
     }
-    
-    // Simulate loading on the cloned track, and do a beatgrid analysis.
-    AudioTrack* clone_ptr = track_clone.release();
-    clone_ptr->load();
-    clone_ptr->analyze_beatgrid();
+    return loadTrackToCache(TrackHandle(track_clone.release()));
+}
+
+void DJControllerService::set_cache_size(size_t new_size) {
+    size_t shards = cache.shardCount();
+    cache.set_capacity(new_size);
+    if (cache.shardCount() != shards) {
+        // Re-sharded: the per-shard policies went with the old shards
+        belady.clear();
+        lookahead = 0;
+    }
+}
 
-    //Wrap the prepared clone in a new PointerWrapper
-    PointerWrapper<AudioTrack> wrapped_clone(clone_ptr);
+void DJControllerService::set_cache_byte_budget(size_t bytes) {
+    cache.set_byte_budget(bytes);
+}
 
-    // Insert into cache and move ownership into cache
-    bool eviction = cache.put(std::move(wrapped_clone));
+void DJControllerService::set_cache_shards(size_t shards) {
+    cache.set_shard_count(shards);
+    belady.clear();
+    lookahead = 0;
+}
 
-    if(eviction){
-        // (d) MISS with eviction
-        return -1;
+bool DJControllerService::set_cache_policy(const std::string& policy_name) {
+    if (!is_known_eviction_policy(policy_name)) {
+        DJ_LOG(Warn, Controller) << "[WARNING] Unknown cache policy '" << policy_name << "', keeping "
+                  << cache.policyName() << std::endl;
+        return false;
     }
-    // (e) MISS without eviction
-    return 0;
+    for (size_t i = 0; i < cache.shardCount(); ++i) {
+        cache.set_policy(i, make_eviction_policy(policy_name, cache.shardCapacity(i)));
+    }
+    belady.clear();
+    lookahead = 0;
+    return true;
 }
 
-void DJControllerService::set_cache_size(size_t new_size) {
-    cache.set_capacity(new_size);
+const char* DJControllerService::getCachePolicyName() const {
+    return cache.policyName();
+}
+
+bool DJControllerService::isCacheable(const AudioTrack& track) const {
+    return cache.canFit(track.get_title(), track.get_memory_footprint());
 }
 //implemented
 void DJControllerService::displayCacheStatus() const {
-    std::cout << "\n=== Cache Status ===\n";
+    DJ_LOG(Info, Controller) << "\n=== Cache Status ===\n";
     cache.displayStatus();
-    std::cout << "====================\n";
+    DJ_LOG(Info, Controller) << "====================\n";
 }
 
 /**
@@ -62,3 +103,60 @@ AudioTrack* DJControllerService::getTrackFromCache(const std::string& track_titl
     // Ownership remains with the LRUCache, fulfilling the requirement.
     return cache.get(track_title);
 }
+
+void DJControllerService::set_lookahead(size_t tracks) {
+    if (tracks == 0) {
+        if (!belady.empty()) {
+            for (size_t i = 0; i < cache.shardCount(); ++i) {
+                cache.set_policy(i, PointerWrapper<EvictionPolicy>());
+            }
+            belady.clear();
+        }
+        lookahead = 0;
+        return;
+    }
+    if (belady.empty()) {
+        // Every shard plans against the same play order
+        for (size_t i = 0; i < cache.shardCount(); ++i) {
+            BeladyPolicy* policy = new BeladyPolicy(&schedule, cache.shardCapacity(i));
+            belady.push_back(policy);
+            cache.set_policy(i, PointerWrapper<EvictionPolicy>(policy));
+        }
+    }
+    lookahead = tracks;
+}
+
+void DJControllerService::set_upcoming_tracks(const std::vector<std::string>& titles) {
+    schedule.reset(titles);
+}
+
+void DJControllerService::advance_to(size_t position) {
+    schedule.advance_to(position);
+}
+
+bool DJControllerService::prefetchTrack(const TrackHandle& track, size_t use_position) {
+    if (belady.empty() || !track || cache.contains(track->get_title())) {
+        return false;
+    }
+    // Never evict something that is played before the prefetched track:
+    // every entry put() would evict, for slots or for bytes, must be used later
+    size_t shard = cache.shardOf(track->get_title());
+    const BeladyPolicy& policy = *belady[shard];
+    const size_t bytes = track->get_memory_footprint();
+    bool evicts_sooner = false;
+    cache.inspectShard(shard, [&](const LRUCache& shard_cache) {
+        std::vector<std::pair<size_t, size_t> > order = policy.evictionOrder();
+        std::vector<size_t> victims;
+        victims.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            victims.push_back(order[i].second);
+        }
+        size_t evicted = shard_cache.evictionsNeeded(bytes, victims);
+        // Furthest first, so the last victim is the one used soonest
+        evicts_sooner = evicted > 0 && order[evicted - 1].first <= use_position;
+    });
+    if (evicts_sooner) {
+        return false;
+    }
+    return loadTrackToCache(track) != -2;
+}
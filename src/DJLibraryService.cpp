@@ -2,13 +2,15 @@
 #include "SessionFileParser.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
-#include <iostream>
+#include "LibraryAnalyzer.h"
+#include "LibrarySnapshot.h"
+#include "Logger.h"
 #include <memory>
 #include <filesystem>
 
 
 DJLibraryService::DJLibraryService(const Playlist& playlist) 
-    : playlist(playlist), library() {}
+    : playlist(playlist), library(), bpm_index(), search_index(), search_indexing(true) {}
 /**
  * @brief Load a playlist from track indices referencing the library
  * @param library_tracks Vector of track info from config
@@ -16,48 +18,108 @@ DJLibraryService::DJLibraryService(const Playlist& playlist)
 void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks) {    
     for (size_t i = 0; i < library_tracks.size(); ++i) {
         // (a) check foramt
-        AudioTrack* newTrack = nullptr;
-        if(library_tracks[i].type == "MP3"){
-            // (b) create appropriate MP3 track type 
-            newTrack = new MP3Track(library_tracks[i].title, library_tracks[i].artists,
-                 library_tracks[i].duration_seconds,
-                 library_tracks[i].bpm,library_tracks[i].extra_param1, // extra_param1 = bitrate,
-                 library_tracks[i].extra_param2);  // extra_param2 = has_tags
-        }
-        // (b) create appropriate WAV track type
-        else{
-            newTrack = new WAVTrack(library_tracks[i].title, library_tracks[i].artists,
-                 library_tracks[i].duration_seconds,
-                 library_tracks[i].bpm,library_tracks[i].extra_param1, // extra_param1 = sample_rate,
-                 library_tracks[i].extra_param2);  // extra_param2 = bit_depth
-        }
-
-        // (c) store in the library vector
-        library.push_back(newTrack);
+        const SessionConfig::TrackInfo& info = library_tracks[i];
+        addTrack(info.type != "MP3", info.title, info.artists, info.duration_seconds,
+                 info.bpm, info.extra_param1, info.extra_param2);
         
         // (d) print log creation message
     }
-    std::cout << "[INFO] Track library built: " 
+    search_index.sort_vocabulary();
+    rebuildBpmIndex();
+    DJ_LOG(Info, Library) << "[INFO] Track library built: " 
                       << library_tracks.size() << " tracks loaded" << std::endl; 
 }
 
+void DJLibraryService::buildLibrary(const SnapshotTrackTable& tracks) {
+    // Reused for every track, so the only string allocations are the tracks' own
+    std::string title;
+    std::vector<std::string> artists;
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const SnapshotTrackTable::Entry entry = tracks.track(i);
+        title.assign(entry.title.data, entry.title.size);
+        artists.resize(entry.artist_count);
+        for (size_t a = 0; a < entry.artist_count; ++a) {
+            const StringRef artist = tracks.artist(i, a);
+            artists[a].assign(artist.data, artist.size);
+        }
+        addTrack(entry.wav, title, artists, entry.duration_seconds,
+                 entry.bpm, entry.extra_param1, entry.extra_param2);
+    }
+    search_index.sort_vocabulary();
+    rebuildBpmIndex();
+    DJ_LOG(Info, Library) << "[INFO] Track library built: " 
+                      << tracks.size() << " tracks loaded" << std::endl; 
+}
+
+void DJLibraryService::buildLibrary(const SessionConfig& config) {
+    if (config.snapshot_tracks) {
+        buildLibrary(*config.snapshot_tracks);
+    } else {
+        buildLibrary(config.library_tracks);
+    }
+}
+
+void DJLibraryService::addTrack(bool wav, const std::string& title, const std::vector<std::string>& artists,
+                                int duration_seconds, int bpm, int extra_param1, int extra_param2) {
+    AudioTrack* newTrack = nullptr;
+    if (!wav) {
+        // (b) create appropriate MP3 track type 
+        newTrack = new MP3Track(title, artists, duration_seconds, bpm,
+                                extra_param1,   // extra_param1 = bitrate,
+                                extra_param2);  // extra_param2 = has_tags
+    }
+    // (b) create appropriate WAV track type
+    else {
+        newTrack = new WAVTrack(title, artists, duration_seconds, bpm,
+                                extra_param1,   // extra_param1 = sample_rate,
+                                extra_param2);  // extra_param2 = bit_depth
+    }
+
+    // (c) store in the library vector; the handle owns the track
+    if (search_indexing) {
+        search_index.add(static_cast<uint32_t>(library.size()), title, artists);
+    }
+    library.push_back(TrackHandle(newTrack));
+}
+
+void DJLibraryService::setSearchIndexing(bool enabled) {
+    if (enabled == search_indexing) {
+        return;
+    }
+    search_indexing = enabled;
+    search_index.clear();
+    if (enabled) {
+        for (size_t i = 0; i < library.size(); ++i) {
+            search_index.add(static_cast<uint32_t>(i), library[i]->get_title(), library[i]->get_artists());
+        }
+        search_index.sort_vocabulary();
+    }
+}
+
+size_t DJLibraryService::analyzeLibrary(size_t threads) {
+    LibraryAnalyzer analyzer(threads);
+    const size_t detected = analyzer.analyze(library);
+    rebuildBpmIndex();
+    return detected;
+}
+
 /**
  * @brief Display the current state of the DJ library playlist
  * 
  */
 void DJLibraryService::displayLibrary() const {
-    std::cout << "=== DJ Library Playlist: " 
+    DJ_LOG(Info, Library) << "=== DJ Library Playlist: " 
               << playlist.get_name() << " ===" << std::endl;
 
     if (playlist.is_empty()) {
-        std::cout << "[INFO] Playlist is empty.\n";
+        DJ_LOG(Info, Library) << "[INFO] Playlist is empty.\n";
         return;
     }
 
     // Let Playlist handle printing all track info
     playlist.display();
 
-    std::cout << "Total duration: " << playlist.get_total_duration() << " seconds" << std::endl;
+    DJ_LOG(Info, Library) << "Total duration: " << playlist.get_total_duration() << " seconds" << std::endl;
 }
 
 /**
@@ -79,10 +141,14 @@ AudioTrack* DJLibraryService::findTrack(const std::string& track_title) {
     return playlist.find_track(track_title);
 }
 
+TrackHandle DJLibraryService::findTrackHandle(const std::string& track_title) const {
+    return playlist.find_track_handle(track_title);
+}
+
 void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name, 
                                                const std::vector<int>& track_indices) {
     // (a) Print Log
-    std::cout << "[INFO] Loading playlist: " << playlist_name << std::endl;
+    DJ_LOG(Info, Library) << "[INFO] Loading playlist: " << playlist_name << std::endl;
 
     // (b) Create a new Playlist with the given name and update member variable
     playlist = Playlist(playlist_name);
@@ -92,32 +158,22 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
         // Validate index is within library bounds.
         int index = track_indices[i] - 1; // Convert 1-based to 0-based index
         if (index < 0 || index >= int(library.size())){
-            std::cout << "[WARNING] Track index " << track_indices[i] 
+            DJ_LOG(Warn, Library) << "[WARNING] Track index " << track_indices[i] 
                       << " is out of bounds. Skipping." << std::endl;
             continue; 
         }
         else{
-            // Clone the track polymorphically and add to playlist
-            PointerWrapper<AudioTrack> cloned_track = library[index]->clone();
-            
-            // If clone is nullptr, log error and skip
-            if(!cloned_track){
-                std::cout << "[ERROR] Cloning track failed for index: " << track_indices[i] << "\n";
-                continue;
-            }
-            
-            cloned_track->load();
-            cloned_track->analyze_beatgrid();
-
-            // Get title while wrapper is valid
-            std::string track_title = cloned_track->get_title(); 
-
-            // Add cloned track to playlist
-            playlist.add_track(cloned_track.release());
+            // Share the library's track with the playlist (no clone)
+            const TrackHandle& track = library[index];
+
+            track->load();
+            track->analyze_beatgrid();
+
+            playlist.add_track(track);
         }   
     }
     // log summary 
-    std::cout << "[INFO] Playlist loaded: " << playlist_name << " (" << playlist.get_track_count() << " tracks)" << std::endl;
+    DJ_LOG(Info, Library) << "[INFO] Playlist loaded: " << playlist_name << " (" << playlist.get_track_count() << " tracks)" << std::endl;
 
     // For now, add a placeholder to fix the linker error
     (void)playlist_name;  // Suppress unused parameter warning
@@ -129,12 +185,81 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
  * @return Vector of track titles in the playlist
  */
 std::vector<std::string> DJLibraryService::getTrackTitles() const {
-    std::vector<std::string> titles; // vector for titles
-    std::vector<AudioTrack*> tracks = playlist.getTracks(); // vector for tracks
-    
-    for(size_t i = 0; i < tracks.size(); ++i){
-        titles.push_back(tracks[i]->get_title()); // push each track's title to titles vector 
+    std::vector<std::string> titles; // vector for titles, in play order
+    titles.reserve(playlist.get_track_count());
+
+    for (Playlist::const_iterator it = playlist.begin(); it != playlist.end(); ++it) {
+        titles.push_back((*it)->get_title()); // push each track's title to titles vector
     }
 
     return titles; 
 }
+
+std::vector<TrackHandle> DJLibraryService::findCompatibleTracks(int bpm, int tolerance,
+                                                                const BpmIndex::Filter& filter,
+                                                                size_t limit) const {
+    std::vector<uint32_t> indices;
+    indices.reserve(limit);
+    bpm_index.find_nearest(bpm, limit, tolerance, filter, indices);
+    return toHandles(indices);
+}
+
+bool DJLibraryService::checkSearchIndexing(const char* operation) const {
+    if (!search_indexing) {
+        DJ_LOG_ERR(Error, Library) << "[ERROR] " << operation << ": search indexing is off "
+                  << "(setSearchIndexing(true) to search the library)" << std::endl;
+    }
+    return search_indexing;
+}
+
+std::vector<TrackHandle> DJLibraryService::searchTracks(const std::string& query, size_t limit,
+                                                        SearchField field) const {
+    if (!checkSearchIndexing("searchTracks")) {
+        return std::vector<TrackHandle>();
+    }
+    return toHandles(search_index.search(query, field, limit));
+}
+
+std::vector<TrackHandle> DJLibraryService::findTracksByArtists(const std::vector<std::string>& artists,
+                                                               size_t limit) const {
+    if (!checkSearchIndexing("findTracksByArtists")) {
+        return std::vector<TrackHandle>();
+    }
+    return toHandles(search_index.find_by_artists(artists, limit));
+}
+
+std::vector<std::string> DJLibraryService::completeSearch(const std::string& prefix, size_t limit) const {
+    if (!checkSearchIndexing("completeSearch")) {
+        return std::vector<std::string>();
+    }
+    return search_index.complete(prefix, limit);
+}
+
+std::vector<TrackHandle> DJLibraryService::toHandles(const std::vector<uint32_t>& indices) const {
+    std::vector<TrackHandle> tracks;
+    tracks.reserve(indices.size());
+    for (uint32_t index : indices) {
+        tracks.push_back(library[index]);
+    }
+    return tracks;
+}
+
+TrackHandle DJLibraryService::getLibraryTrack(size_t index) const {
+    return index < library.size() ? library[index] : TrackHandle();
+}
+
+void DJLibraryService::rebuildBpmIndex() {
+    std::vector<BpmIndex::Entry> entries;
+    entries.reserve(library.size());
+    for (size_t i = 0; i < library.size(); ++i) {
+        const AudioTrack& track = *library[i];
+        BpmIndex::Entry entry;
+        entry.library_index = static_cast<uint32_t>(i);
+        entry.bpm = track.get_bpm();
+        entry.quality = track.get_analysis() ? track.get_analysis()->quality
+                                             : static_cast<float>(track.get_quality_score());
+        entry.kind = dynamic_cast<const WAVTrack*>(&track) ? TrackKind::WAV : TrackKind::MP3;
+        entries.push_back(entry);
+    }
+    bpm_index.build(entries);
+}
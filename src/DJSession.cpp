@@ -1,14 +1,53 @@
 
 #include "DJSession.h"
+#include "LibrarySnapshot.h"
+#include "Logger.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <thread>
 #include <dirent.h>
+#include <sys/resource.h>
+
+namespace {
+
+// Live render: block size, and blocks played after each deck load
+const size_t RENDER_BLOCK_FRAMES = 256;
+const size_t PLAYBACK_BLOCKS = 4;
+
+std::string json_escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string format_us(uint64_t ns) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << ns / 1000.0;
+    return text.str();
+}
+
+}  // namespace
 
 // ========== CONSTRUCTORS & RULE OF 5 ==========
 
 
-DJSession::DJSession(const std::string& name, bool play_all)
+DJSession::DJSession(const std::string& name, bool play_all, const std::string& config_path)
     : session_name(name),
     library_service(),
     controller_service(),
@@ -16,25 +55,31 @@ DJSession::DJSession(const std::string& name, bool play_all)
     config_manager(),
     session_config(),
     track_titles(),
+    config_path(config_path),
+    snapshot_path(),
     play_all(play_all),
+    analyze_library(false),
+    live_render(false),
+    stats_path(),
+    render_report(),
     stats()
       {
-    std::cout << "DJ Session System initialized: " << session_name << std::endl;
+    DJ_LOG(Info, Session) << "DJ Session System initialized: " << session_name << std::endl;
 }
 
 
 DJSession::~DJSession() {
-    std::cout << "Shutting down DJ Session System: " << session_name << std::endl;
+    DJ_LOG(Info, Session) << "Shutting down DJ Session System: " << session_name << std::endl;
 }
 
 // ========== CORE FUNCTIONALITY ==========
 bool DJSession::load_playlist(const std::string& playlist_name)  {
-    std::cout << "[System] Loading playlist: " << playlist_name << "\n";
+    DJ_LOG(Info, Session) << "[System] Loading playlist: " << playlist_name << "\n";
     
     // Find the playlist in the session config
     auto it = session_config.playlists.find(playlist_name);
     if (it == session_config.playlists.end()) {
-        std::cerr << "[ERROR] Playlist '" << playlist_name << "' not found in configuration.\n";
+        DJ_LOG_ERR(Error, Session) << "[ERROR] Playlist '" << playlist_name << "' not found in configuration.\n";
         return false;
     }
     
@@ -47,8 +92,10 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
     
     track_titles = library_service.getTrackTitles();
 
-    // Reverse title sort name
-    std::reverse(track_titles.begin(), track_titles.end());
+    // Lookahead mode plans evictions and prefetches from the play order
+    if (controller_service.get_lookahead() > 0) {
+        controller_service.set_upcoming_tracks(track_titles);
+    }
     
     return true;
 }
@@ -70,27 +117,28 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
  *    1: Cache HIT
  *    0: Cache MISS (or error)
  *   -1: Cache MISS with eviction
+ *   -2: Track too large for the cache (counted as an error)
  * 
  * @param track_name: Name of track to load
  * @return: Cache operation result code
 
  */
 int DJSession::load_track_to_controller(const std::string& track_name) {
-    // (a) Find track in library (non-owning raw pointer)
-    AudioTrack* track = library_service.findTrack(track_name);
+    // (a) Find track in library (shared handle, nothing is copied)
+    TrackHandle track = library_service.findTrackHandle(track_name);
 
     // (b) If track not found, log error and return 0 (MISS)
     if (!track) {
-        std::cerr << "[ERROR] Track '" << track_name << "' not found in library.\n";
+        DJ_LOG_ERR(Error, Session) << "[ERROR] Track '" << track_name << "' not found in library.\n";
         stats.errors++;
         return 0; // MISS
     }
 
     // (c) 
-    std::cout << "[System] Loading track '" << track_name << "' to controller..." << std::endl;
+    DJ_LOG(Info, Session) << "[System] Loading track '" << track_name << "' to controller..." << std::endl;
 
     // (d) load track and hold eviction result 
-    int evict_result = controller_service.loadTrackToCache(*track); 
+    int evict_result = controller_service.loadTrackToCache(track);
 
     // (e) Interpret return value according to contract
      if(evict_result==1){
@@ -100,6 +148,10 @@ int DJSession::load_track_to_controller(const std::string& track_name) {
     } else if(evict_result==-1){
        stats.cache_misses++;
        stats.cache_evictions++;
+    } else if(evict_result==-2){
+       DJ_LOG_ERR(Error, Session) << "[ERROR] Track '" << track_name
+                  << "' exceeds the cache byte budget; it will play from the library.\n";
+       stats.errors++;
     }
 
     // (f)
@@ -113,13 +165,22 @@ int DJSession::load_track_to_controller(const std::string& track_name) {
  * @return: Whether track was successfully loaded to a deck
  */
 bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
-    std::cout << "[System] Delegating track transfer to MixingEngineService for: " << track_title << std::endl;
+    DJ_LOG(Info, Session) << "[System] Delegating track transfer to MixingEngineService for: " << track_title << std::endl;
     // (a) Retrieve track from controller cache (non-owning raw pointer)
     AudioTrack* track = controller_service.getTrackFromCache(track_title);
 
+    // Tracks too large for the cache go to the deck straight from the library
+    TrackHandle uncached;
+    if (!track) {
+        uncached = library_service.findTrackHandle(track_title);
+        if (uncached && !controller_service.isCacheable(*uncached)) {
+            track = uncached.get();
+        }
+    }
+
     // (b) If track not found in cache, log error and return false
     if (!track) {
-        std::cerr << " [ERROR] Track: '" << track_title << "' not found in cache.\n";
+        DJ_LOG_ERR(Error, Session) << " [ERROR] Track: '" << track_title << "' not found in cache.\n";
         stats.errors++;
         return false;
     }
@@ -137,7 +198,7 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
     }
     else{
         stats.errors++;
-        std::cerr << " [ERROR] Failed to load track to mixer deck.\n";
+        DJ_LOG_ERR(Error, Session) << " [ERROR] Failed to load track to mixer deck.\n";
         return false;
     }
     return true;
@@ -150,27 +211,35 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
  */
 void DJSession::simulate_dj_performance() {
     // (a) Configuration and intialization
-    std::cout << "=== DJ Controller System ===" << std::endl;
-    std::cout << "Starting interactive DJ session..." << std::endl;
+    DJ_LOG(Info, Session) << "=== DJ Controller System ===" << std::endl;
+    DJ_LOG(Info, Session) << "Starting interactive DJ session..." << std::endl;
     // 1. Load configuration
     if (!load_configuration()) {
-        std::cerr << "[ERROR] Failed to load configuration. Aborting session." << std::endl;
+        DJ_LOG_ERR(Error, Session) << "[ERROR] Failed to load configuration. Aborting session." << std::endl;
         return;
     }
     
     // 2. Build track library from config
-    library_service.buildLibrary(session_config.library_tracks);
+    library_service.buildLibrary(session_config);
+    if (analyze_library) {
+        library_service.analyzeLibrary();
+    }
+    if (live_render) {
+        mixing_service.setRenderingEnabled(true);
+        mixing_service.startRenderThread(RENDER_BLOCK_FRAMES);
+    }
     
     // 3. Get available playlists from config
     if (session_config.playlists.empty()) {
-        std::cerr << "[ERROR] No playlists found in configuration. Aborting session." << std::endl;
+        DJ_LOG_ERR(Error, Session) << "[ERROR] No playlists found in configuration. Aborting session." << std::endl;
         return;
     }
-    std::cout << "\nStarting DJ performance simulation..." << std::endl;
-    std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
-    std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
-    std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots (LRU policy)" << std::endl;
-    std::cout << "\n--- Processing Tracks ---" << std::endl;    
+    DJ_LOG(Info, Session) << "\nStarting DJ performance simulation..." << std::endl;
+    DJ_LOG(Info, Session) << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
+    DJ_LOG(Info, Session) << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
+    DJ_LOG(Info, Session) << "Cache Capacity: " << session_config.controller_cache_size << " slots ("
+              << controller_service.getCachePolicyName() << " policy)" << std::endl;
+    DJ_LOG(Info, Session) << "\n--- Processing Tracks ---" << std::endl;    
 
     // (b) playlist selection loop
 
@@ -190,15 +259,16 @@ void DJSession::simulate_dj_performance() {
             // Load playlist
             if(!load_playlist(playlist_names[i])){
                 // Log error and continue to next playlist
-                std::cerr << "[Error] Playlist " << playlist_names[i] << "failed to load" << std::endl;
+                DJ_LOG_ERR(Error, Session) << "[Error] Playlist " << playlist_names[i] << "failed to load" << std::endl;
                 continue;
             }
 
             // each load updates track_titles and then process each track
             for(size_t j = 0; j < track_titles.size(); j++){ 
                 std::string current_track = track_titles[j];
-                std::cout << "\n--- Processing: " << current_track << " ---" << std::endl;
+                DJ_LOG(Info, Session) << "\n--- Processing: " << current_track << " ---" << std::endl;
                 stats.tracks_processed++;
+                prefetch_upcoming(j);
                 
                 // Load track to controller
                 load_track_to_controller(current_track);
@@ -210,10 +280,17 @@ void DJSession::simulate_dj_performance() {
                 if(!load_track_to_mixer_deck(current_track)){
                     continue;
                 }
+                if (live_render) {
+                    play_rendered(PLAYBACK_BLOCKS);
+                }
                 mixing_service.displayDeckStatus();
             }            
             print_session_summary();
         }
+        // One dump for the whole session, matching the last summary
+        if (!stats_path.empty()) {
+            write_stats_dump();
+        }
         // Reset stats for next playlist
         stats = SessionStats();
     }
@@ -233,15 +310,16 @@ void DJSession::simulate_dj_performance() {
             // Load playlist
             if(!load_playlist(selected_playlist)){ // (d) breaks when the user selects so
                 // Log error and continue to next playlist
-                std::cerr << "[Error] Playlist " << selected_playlist << " failed to load" << std::endl;
+                DJ_LOG_ERR(Error, Session) << "[Error] Playlist " << selected_playlist << " failed to load" << std::endl;
                 continue;
             }
 
             // each load updates track_titles and then process each track
             for(size_t j = 0; j < track_titles.size(); j++){
                 std::string current_track = track_titles[j];
-                std::cout << "\n--- Processing: " << current_track << " ---" << std::endl;
+                DJ_LOG(Info, Session) << "\n--- Processing: " << current_track << " ---" << std::endl;
                 stats.tracks_processed++;
+                prefetch_upcoming(j);
                 
                 // Load track to controller
                 load_track_to_controller(current_track);
@@ -253,41 +331,172 @@ void DJSession::simulate_dj_performance() {
                 if(!load_track_to_mixer_deck(current_track)){
                     continue;
                 }
+                if (live_render) {
+                    play_rendered(PLAYBACK_BLOCKS);
+                }
             mixing_service.displayDeckStatus();
             }
             print_session_summary();
         }// end of while
+        if (!stats_path.empty()) {
+            write_stats_dump();
+        }
         // Reset stats for next playlist
             stats = SessionStats();
     }
     // (e)
-    std::cout << "\n[System] DJ session ended by user or all playlists played." << std::endl;   
+    DJ_LOG(Info, Session) << "\n[System] DJ session ended by user or all playlists played." << std::endl;   
 }
 
 
+namespace {
+
+typedef std::chrono::steady_clock StageClock;
+
+double elapsed_ms(StageClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(StageClock::now() - start).count();
+}
+
+long peak_rss_kb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;  // kilobytes on Linux
+}
+
+}  // namespace
+
+bool DJSession::run_scale_test() {
+    StageClock::time_point session_start = StageClock::now();
+    double parse_ms = 0, library_ms = 0, analysis_ms = 0, playlist_ms = 0, controller_ms = 0, mixer_ms = 0;
+    size_t playlists_played = 0;
+
+    // Only errors are printed while the session runs
+    Logger::set_quiet(true);
+
+    StageClock::time_point start = StageClock::now();
+    bool configured = load_configuration();
+    parse_ms = elapsed_ms(start);
+
+    if (configured) {
+        // The scale test never searches: skip building the search index
+        library_service.setSearchIndexing(false);
+        start = StageClock::now();
+        library_service.buildLibrary(session_config);
+        library_ms = elapsed_ms(start);
+
+        if (analyze_library) {
+            start = StageClock::now();
+            library_service.analyzeLibrary();
+            analysis_ms = elapsed_ms(start);
+        }
+
+        std::vector<std::string> playlist_names;
+        for (const auto& pair : session_config.playlists) {
+            playlist_names.push_back(pair.first);
+        }
+        std::sort(playlist_names.begin(), playlist_names.end());
+
+        for (size_t i = 0; i < playlist_names.size(); ++i) {
+            start = StageClock::now();
+            bool loaded = load_playlist(playlist_names[i]);
+            playlist_ms += elapsed_ms(start);
+            if (!loaded) {
+                continue;
+            }
+            playlists_played++;
+
+            for (size_t j = 0; j < track_titles.size(); ++j) {
+                stats.tracks_processed++;
+                start = StageClock::now();
+                prefetch_upcoming(j);
+                load_track_to_controller(track_titles[j]);
+                controller_ms += elapsed_ms(start);
+
+                start = StageClock::now();
+                load_track_to_mixer_deck(track_titles[j]);
+                mixer_ms += elapsed_ms(start);
+            }
+        }
+    }
+
+    Logger::set_quiet(false);
+    if (!configured) {
+        return false;
+    }
+
+    DJ_LOG(Info, Session) << "\n=== Scale Test Report ===" << std::endl;
+    DJ_LOG(Info, Session) << "Config: " << config_path << std::endl;
+    DJ_LOG(Info, Session) << "Library tracks: " << session_config.library_size() << std::endl;
+    DJ_LOG(Info, Session) << "Playlists played: " << playlists_played << "/" << session_config.playlists.size() << std::endl;
+    DJ_LOG(Info, Session) << "Tracks processed: " << stats.tracks_processed << std::endl;
+    DJ_LOG(Info, Session) << "Cache hits: " << stats.cache_hits << ", misses: " << stats.cache_misses
+                          << ", evictions: " << stats.cache_evictions << std::endl;
+    DJ_LOG(Info, Session) << "Errors: " << stats.errors << std::endl;
+    DJ_LOG(Info, Session) << "--- Stage timings (ms) ---" << std::endl;
+    DJ_LOG(Info, Session) << "Parse configuration: " << parse_ms << std::endl;
+    DJ_LOG(Info, Session) << "Build library: " << library_ms << std::endl;
+    if (analyze_library) {
+        DJ_LOG(Info, Session) << "Analyze library: " << analysis_ms << std::endl;
+    }
+    DJ_LOG(Info, Session) << "Load playlists: " << playlist_ms << std::endl;
+    DJ_LOG(Info, Session) << "Controller loads: " << controller_ms << std::endl;
+    DJ_LOG(Info, Session) << "Mixer loads: " << mixer_ms << std::endl;
+    DJ_LOG(Info, Session) << "Wall time: " << elapsed_ms(session_start) << " ms" << std::endl;
+    DJ_LOG(Info, Session) << "Peak RSS: " << peak_rss_kb() << " KB" << std::endl;
+    DJ_LOG(Info, Session) << "=========================" << std::endl;
+    if (!stats_path.empty()) {
+        render_report = mixing_service.getRenderTelemetry();
+        write_stats_dump();
+    }
+    return true;
+}
+
 /* 
  * Helper method to load session configuration from file
  * 
  * @return: true if configuration loaded successfully; false on error
  */
 bool DJSession::load_configuration() {
-    const std::string config_path = "bin/dj_config.txt";
-    
-    std::cout << "Loading configuration from: " << config_path << std::endl;
+    DJ_LOG(Info, Session) << "Loading configuration from: " << config_path << std::endl;
     
-    if (!SessionFileParser::parse_config_file(config_path, session_config)) {
-        std::cerr << "[ERROR] Failed to parse configuration file: " << config_path << std::endl;
-        return false;
+    if (!snapshot_path.empty() && LibrarySnapshot::load(snapshot_path, config_path, session_config)) {
+        DJ_LOG(Info, Session) << "Loaded library snapshot: " << snapshot_path << " ("
+                  << session_config.library_size() << " tracks, "
+                  << session_config.playlists.size() << " playlists)" << std::endl;
+    } else {
+        if (!SessionFileParser::parse_config_file(config_path, session_config)) {
+            DJ_LOG_ERR(Error, Session) << "[ERROR] Failed to parse configuration file: " << config_path << std::endl;
+            return false;
+        }
+        if (!snapshot_path.empty() && LibrarySnapshot::write(snapshot_path, config_path, session_config)) {
+            DJ_LOG(Info, Session) << "Wrote library snapshot: " << snapshot_path << std::endl;
+        }
     }
     
-    std::cout << "Configuration loaded successfully." << std::endl;
-    std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
-    std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
-    std::cout << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    DJ_LOG(Info, Session) << "Configuration loaded successfully." << std::endl;
+    DJ_LOG(Info, Session) << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
+    DJ_LOG(Info, Session) << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
+    DJ_LOG(Info, Session) << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    if (session_config.controller_cache_bytes != 0) {
+        DJ_LOG(Info, Session) << "Cache Byte Budget: " << session_config.controller_cache_bytes << " bytes" << std::endl;
+    }
     mixing_service.set_auto_sync(session_config.auto_sync);
     mixing_service.set_bpm_tolerance(session_config.bpm_tolerance);
-    //update cache size in LRUCache
+    //update cache size in LRUCache (first, so the shard count is clamped to the configured size)
     controller_service.set_cache_size(session_config.controller_cache_size);
+    if (session_config.controller_cache_shards > 1) {
+        DJ_LOG(Info, Session) << "Cache Shards: " << session_config.controller_cache_shards << std::endl;
+        controller_service.set_cache_shards(static_cast<size_t>(session_config.controller_cache_shards));
+    }
+    controller_service.set_cache_byte_budget(session_config.controller_cache_bytes);
+    controller_service.set_cache_policy(session_config.cache_policy);
+    if (session_config.controller_lookahead > 0) {
+        DJ_LOG(Info, Session) << "Cache Lookahead: " << session_config.controller_lookahead
+                  << " tracks (Belady eviction)" << std::endl;
+        controller_service.set_lookahead(static_cast<size_t>(session_config.controller_lookahead));
+    }
     return true;
 }
 
@@ -296,7 +505,7 @@ std::string DJSession::display_playlist_menu_from_config() {
         return "";
     }
     
-    std::cout << "\n=== Available Playlists ===" << std::endl;
+    DJ_LOG(Info, Session) << "\n=== Available Playlists ===" << std::endl;
     
     // Build sorted list of playlist names
     std::vector<std::string> playlist_names;
@@ -307,18 +516,20 @@ std::string DJSession::display_playlist_menu_from_config() {
     
     // Display numbered list
     for (size_t i = 0; i < playlist_names.size(); ++i) {
-        std::cout << (i + 1) << ". " << playlist_names[i] << std::endl;
+        DJ_LOG(Info, Session) << (i + 1) << ". " << playlist_names[i] << std::endl;
     }
-    std::cout << "0. Cancel" << std::endl;
+    DJ_LOG(Info, Session) << "0. Cancel" << std::endl;
     
     // Prompt for user selection with validation
     int selection = -1;
     while (true) {
-        std::cout << "\nSelect a playlist (1-" << playlist_names.size() << ", 0 to cancel): ";
+        DJ_LOG(Info, Session) << "\nSelect a playlist (1-" << playlist_names.size() << ", 0 to cancel): ";
         std::string input;
-        
+
+        // The prompt must be on screen before blocking on input
+        Logger::flush();
         if (!std::getline(std::cin, input)) {
-            std::cout << "\n[ERROR] Input error. Cancelling session." << std::endl;
+            DJ_LOG(Error, Session) << "\n[ERROR] Input error. Cancelling session." << std::endl;
             return "";
         }
         
@@ -328,26 +539,105 @@ std::string DJSession::display_playlist_menu_from_config() {
                 return "";
             } else if (selection >= 1 && selection <= static_cast<int>(playlist_names.size())) {
                 std::string selected_name = playlist_names[selection - 1];
-                std::cout << "Selected: " << selected_name << std::endl;
+                DJ_LOG(Info, Session) << "Selected: " << selected_name << std::endl;
                 return selected_name;
             }
         }
         
-        std::cout << "Invalid selection. Please enter a number between 1 and " 
+        DJ_LOG(Info, Session) << "Invalid selection. Please enter a number between 1 and " 
                   << playlist_names.size() << ", or 0 to cancel." << std::endl;
     }
 }
 
-void DJSession::print_session_summary() const {
-    std::cout << "\n=== DJ Session Summary ===" << std::endl;
-    std::cout << "Session: " << session_name << std::endl;
-    std::cout << "Tracks processed: " << stats.tracks_processed << std::endl;
-    std::cout << "Cache hits: " << stats.cache_hits << std::endl;
-    std::cout << "Cache misses: " << stats.cache_misses << std::endl;
-    std::cout << "Cache evictions: " << stats.cache_evictions << std::endl;
-    std::cout << "Deck A loads: " << stats.deck_loads_a << std::endl;
-    std::cout << "Deck B loads: " << stats.deck_loads_b << std::endl;
-    std::cout << "Transitions: " << stats.transitions << std::endl;
-    std::cout << "Errors: " << stats.errors << std::endl;
-    std::cout << "=== Session Complete ===" << std::endl;
+void DJSession::play_rendered(size_t blocks) {
+    const size_t frames = mixing_service.getRenderBlockFrames();
+    std::vector<float> device(frames * MixingEngineService::OUTPUT_CHANNELS);
+    const std::chrono::nanoseconds period(mixing_service.getBlockDeadlineNs());
+    StageClock::time_point next = StageClock::now();
+    for (size_t i = 0; i < blocks; ++i) {
+        next += period;
+        std::this_thread::sleep_until(next);
+        mixing_service.readRenderedFrames(device.data(), frames);   // short: the device plays silence
+    }
+}
+
+void DJSession::prefetch_upcoming(size_t position) {
+    size_t window = controller_service.get_lookahead();
+    if (window == 0) {
+        return;
+    }
+    controller_service.advance_to(position);
+
+    size_t end = std::min(track_titles.size(), position + 1 + window);
+    for (size_t p = position + 1; p < end; ++p) {
+        TrackHandle track = library_service.findTrackHandle(track_titles[p]);
+        if (track && controller_service.prefetchTrack(track, p)) {
+            stats.prefetches++;
+        }
+    }
+}
+
+void DJSession::print_session_summary() {
+    DJ_LOG(Info, Session) << "\n=== DJ Session Summary ===" << std::endl;
+    DJ_LOG(Info, Session) << "Session: " << session_name << std::endl;
+    DJ_LOG(Info, Session) << "Tracks processed: " << stats.tracks_processed << std::endl;
+    DJ_LOG(Info, Session) << "Cache hits: " << stats.cache_hits << std::endl;
+    DJ_LOG(Info, Session) << "Cache misses: " << stats.cache_misses << std::endl;
+    DJ_LOG(Info, Session) << "Cache evictions: " << stats.cache_evictions << std::endl;
+    DJ_LOG(Info, Session) << "Deck A loads: " << stats.deck_loads_a << std::endl;
+    DJ_LOG(Info, Session) << "Deck B loads: " << stats.deck_loads_b << std::endl;
+    DJ_LOG(Info, Session) << "Transitions: " << stats.transitions << std::endl;
+    DJ_LOG(Info, Session) << "Errors: " << stats.errors << std::endl;
+    if (controller_service.get_lookahead() > 0) {
+        DJ_LOG(Info, Session) << "Prefetches: " << stats.prefetches << std::endl;
+    }
+    // One snapshot for the printed lines and the stats dump
+    render_report = mixing_service.getRenderTelemetry();
+    const LatencyHistogram::Summary& render_ns = render_report.render_ns;
+    if (render_ns.count > 0) {
+        DJ_LOG(Info, Session) << "Render blocks: " << render_ns.count << " ("
+                  << render_report.block_frames << " frames, deadline "
+                  << format_us(render_report.deadline_ns) << " us)" << std::endl;
+        DJ_LOG(Info, Session) << "Render time p50/p99/max: " << format_us(render_ns.p50) << " / "
+                  << format_us(render_ns.p99) << " / " << format_us(render_ns.max)
+                  << " us" << std::endl;
+        DJ_LOG(Info, Session) << "Deadline misses (xruns): " << render_report.deadline_misses << std::endl;
+        DJ_LOG(Info, Session) << "Output underruns: " << render_report.underruns << std::endl;
+    }
+    DJ_LOG(Info, Session) << "=== Session Complete ===" << std::endl;
+}
+
+bool DJSession::write_stats_dump() const {
+    std::ofstream out(stats_path.c_str());
+    if (!out) {
+        DJ_LOG_ERR(Error, Session) << "[ERROR] Cannot write stats to: " << stats_path << std::endl;
+        return false;
+    }
+    const LatencyHistogram::Summary& render_ns = render_report.render_ns;
+    out << "{\n";
+    out << "  \"session\": \"" << json_escape(session_name) << "\",\n";
+    out << "  \"tracks_processed\": " << stats.tracks_processed << ",\n";
+    out << "  \"cache_hits\": " << stats.cache_hits << ",\n";
+    out << "  \"cache_misses\": " << stats.cache_misses << ",\n";
+    out << "  \"cache_evictions\": " << stats.cache_evictions << ",\n";
+    out << "  \"deck_loads_a\": " << stats.deck_loads_a << ",\n";
+    out << "  \"deck_loads_b\": " << stats.deck_loads_b << ",\n";
+    out << "  \"transitions\": " << stats.transitions << ",\n";
+    out << "  \"errors\": " << stats.errors << ",\n";
+    out << "  \"prefetches\": " << stats.prefetches << ",\n";
+    out << "  \"render\": {\n";
+    out << "    \"blocks\": " << render_ns.count << ",\n";
+    out << "    \"block_frames\": " << render_report.block_frames << ",\n";
+    out << "    \"deadline_ns\": " << render_report.deadline_ns << ",\n";
+    out << "    \"deadline_misses\": " << render_report.deadline_misses << ",\n";
+    out << "    \"underruns\": " << render_report.underruns << ",\n";
+    out << "    \"render_ns\": {\"mean\": " << render_ns.mean
+        << ", \"p50\": " << render_ns.p50
+        << ", \"p90\": " << render_ns.p90
+        << ", \"p99\": " << render_ns.p99
+        << ", \"p999\": " << render_ns.p999
+        << ", \"max\": " << render_ns.max << "}\n";
+    out << "  }\n";
+    out << "}\n";
+    return static_cast<bool>(out);
 }
\ No newline at end of file
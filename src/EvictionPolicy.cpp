@@ -0,0 +1,43 @@
+#include "EvictionPolicy.h"
+#include "ARCPolicy.h"
+#include "TwoQueuePolicy.h"
+#include "WTinyLFUPolicy.h"
+#include <algorithm>
+
+namespace {
+std::string lower_name(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+}
+
+uint64_t policy_key_hash(const std::string& key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < key.size(); ++i) {
+        hash ^= static_cast<unsigned char>(key[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+PointerWrapper<EvictionPolicy> make_eviction_policy(const std::string& name, size_t capacity) {
+    std::string lower = lower_name(name);
+    if (lower == "arc") {
+        return PointerWrapper<EvictionPolicy>(new ARCPolicy(capacity));
+    }
+    if (lower == "2q") {
+        return PointerWrapper<EvictionPolicy>(new TwoQueuePolicy(capacity));
+    }
+    if (lower == "tinylfu" || lower == "w-tinylfu") {
+        return PointerWrapper<EvictionPolicy>(new WTinyLFUPolicy(capacity));
+    }
+    // "lru" and unknown names: the cache's built-in recency list
+    return PointerWrapper<EvictionPolicy>();
+}
+
+bool is_known_eviction_policy(const std::string& name) {
+    std::string lower = lower_name(name);
+    return lower == "lru" || lower == "arc" || lower == "2q" ||
+           lower == "tinylfu" || lower == "w-tinylfu";
+}
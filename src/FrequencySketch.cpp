@@ -0,0 +1,57 @@
+#include "FrequencySketch.h"
+#include <algorithm>
+
+const size_t FrequencySketch::ROWS;
+const uint8_t FrequencySketch::MAX_COUNT;
+
+FrequencySketch::FrequencySketch(size_t capacity)
+    : table(), width_mask(0), sample_size(0), samples(0) {
+    reset(capacity);
+}
+
+void FrequencySketch::reset(size_t capacity) {
+    size_t width = 16;
+    while (width < capacity * 2) width <<= 1;
+    table.assign(ROWS * width, 0);
+    width_mask = width - 1;
+    sample_size = std::max<size_t>(capacity * 10, 16);
+    samples = 0;
+}
+
+size_t FrequencySketch::indexOf(uint64_t key_hash, size_t row) const {
+    // Derive an independent hash per row (splitmix64 finaliser on a row seed)
+    uint64_t h = key_hash + (row + 1) * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return row * (width_mask + 1) + (static_cast<size_t>(h) & width_mask);
+}
+
+void FrequencySketch::increment(uint64_t key_hash) {
+    // Conservative update: only raise the counters that hold the minimum
+    uint8_t current = estimate(key_hash);
+    if (current < MAX_COUNT) {
+        for (size_t row = 0; row < ROWS; ++row) {
+            uint8_t& counter = table[indexOf(key_hash, row)];
+            if (counter == current) ++counter;
+        }
+    }
+    if (++samples >= sample_size) {
+        age();
+    }
+}
+
+uint8_t FrequencySketch::estimate(uint64_t key_hash) const {
+    uint8_t result = MAX_COUNT;
+    for (size_t row = 0; row < ROWS; ++row) {
+        result = std::min(result, table[indexOf(key_hash, row)]);
+    }
+    return result;
+}
+
+void FrequencySketch::age() {
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] >>= 1;
+    }
+    samples /= 2;
+}
@@ -1,8 +1,15 @@
 #include "LRUCache.h"
-#include <iostream>
+#include "Logger.h"
+#include <algorithm>
+#include <functional>
 
 LRUCache::LRUCache(size_t capacity)
-    : slots(capacity), max_size(capacity), access_counter(0) {}
+    : slots(capacity), max_size(capacity), access_counter(0), index(),
+      mru_slot(CacheSlot::NO_SLOT), lru_slot(CacheSlot::NO_SLOT),
+      occupied_count(0), free_slots(), max_bytes(0), used_bytes(0),
+      policy() {
+    rebuildIndex();
+}
 
 bool LRUCache::contains(const std::string& track_id) const {
     return findSlot(track_id) != max_size;
@@ -11,38 +18,56 @@ bool LRUCache::contains(const std::string& track_id) const {
 AudioTrack* LRUCache::get(const std::string& track_id) {
     size_t idx = findSlot(track_id);
     if (idx == max_size) return nullptr;
+    // Move to the MRU end of the recency list
+    unlink(idx);
+    linkFront(idx);
+    if (policy) policy->onAccess(idx);
     return slots[idx].access(++access_counter);
 }
 
-/**
- * TODO: Implement the put() method for LRUCache
- */
+// Takes ownership of a clone and caches it through a shared handle
 bool LRUCache::put(PointerWrapper<AudioTrack> track) {
+    return put(TrackHandle(track.release()));
+}
+
+bool LRUCache::put(const TrackHandle& track) {
     // (a) Handle nullptr track
     if (!track) {
         return false;
     }
 
     // Use the track title as the identifier
-    const std::string track_id = track->get_title();
+    const std::string& track_id = track->get_title();
 
     // (b) If track already exists, update its access time and return false
     size_t existing = findSlot(track_id);
     if (existing != max_size) {
+        unlink(existing);
+        linkFront(existing);
+        if (policy) policy->onAccess(existing);
         slots[existing].access(++access_counter);
         return false;
     }
 
 
+    // A track larger than the whole byte budget can never fit
+    const size_t incoming_bytes = track->get_memory_footprint();
+    if (!canFit(incoming_bytes)) {
+        DJ_LOG(Warn, Cache) << "[WARNING] Track '" << track_id << "' (" << incoming_bytes
+                  << " bytes) exceeds cache byte budget of " << max_bytes << " bytes; not cached\n";
+        return false;
+    }
+
     bool eviction_occurred = false;
-    // (c) If cache is full, evict LRU first
-    if (isFull()) {
-        eviction_occurred = evictLRU();
+    // (c) If cache is full (slots or bytes), evict LRU until the track fits
+    while (needsEviction(incoming_bytes)) {
+        if (!evictFor(track_id)) break;
+        eviction_occurred = true;
     }
 
     // (d) Find an empty slot
     size_t slot_idx = findEmptySlot();
-    
+
     // recheck if eviction occured
     if (slot_idx == max_size) {
         // No empty slot available even after eviction
@@ -50,90 +75,169 @@ bool LRUCache::put(PointerWrapper<AudioTrack> track) {
     }
 
     // (e) Store the new track with the current access_counter value and mark the slot as occupied
-    // We use std::move(track) to transfer ownership from the parameter to the CacheSlot.
-    slots[slot_idx].store(std::move(track), ++access_counter);
+    // The CacheSlot shares the handle; the track itself is not copied.
+    std::pop_heap(free_slots.begin(), free_slots.end(), std::greater<size_t>());
+    free_slots.pop_back();
+    index[track_id] = slot_idx;
+    slots[slot_idx].store(track, ++access_counter);
+    linkFront(slot_idx);
+    ++occupied_count;
+    used_bytes += slots[slot_idx].getBytes();
+    if (policy) policy->onInsert(slot_idx, track_id);
 
     // (f) Return whether an eviction occurred
     return eviction_occurred;
 }
 
 bool LRUCache::evictLRU() {
-    size_t lru = findLRUSlot();
-    if (lru == max_size || !slots[lru].isOccupied()) return false;
-    slots[lru].clear();
+    return evictFor(std::string());
+}
+
+bool LRUCache::evictFor(const std::string& incoming) {
+    if (occupied_count == 0) return false;
+    size_t victim = findLRUSlot();
+    if (policy) {
+        size_t chosen = policy->selectVictim(incoming);
+        // Fall back to LRU if the policy's bookkeeping has no candidate
+        if (chosen < max_size && slots[chosen].isOccupied()) victim = chosen;
+    }
+    if (victim == max_size || !slots[victim].isOccupied()) return false;
+    releaseSlot(victim);
     return true;
 }
 
 size_t LRUCache::size() const {
-    size_t count = 0;
-    for (const auto& slot : slots) if (slot.isOccupied()) ++count;
-    return count;
+    return occupied_count;
 }
 
 void LRUCache::clear() {
     for (auto& slot : slots) {
         slot.clear();
     }
+    rebuildIndex();
 }
 
 void LRUCache::displayStatus() const {
-    std::cout << "[LRUCache] Status: " << size() << "/" << max_size << " slots used\n";
+    DJ_LOG(Info, Cache) << "[LRUCache] Status: " << size() << "/" << max_size << " slots used\n";
+    if (max_bytes != 0) {
+        DJ_LOG(Info, Cache) << "[LRUCache] Memory: " << used_bytes << "/" << max_bytes
+                  << " bytes used, " << bytesAvailable() << " bytes available\n";
+    }
     for (size_t i = 0; i < max_size; ++i) {
         if(slots[i].isOccupied()){
-            std::cout << "  Slot " << i << ": " << slots[i].getTrack()->get_title()
+            DJ_LOG(Info, Cache) << "  Slot " << i << ": " << slots[i].getTrack()->get_title()
                       << " (last access: " << slots[i].getLastAccessTime() << ")\n";
         } else {
-            std::cout << "  Slot " << i << ": [EMPTY]\n";
+            DJ_LOG(Info, Cache) << "  Slot " << i << ": [EMPTY]\n";
         }
     }
 }
 
 size_t LRUCache::findSlot(const std::string& track_id) const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (slots[i].isOccupied() && slots[i].getTrack()->get_title() == track_id) return i;
-    }
-    return max_size;
-
+    auto it = index.find(track_id);
+    if (it == index.end()) return max_size;
+    return it->second;
 }
 
-/**
- * TODO: Implement the findLRUSlot() method for LRUCache
- */
 size_t LRUCache::findLRUSlot() const {
-    // Initialized to -1 to signify that no occupied slot has been found yet.
-    int index=-1;
-    uint64_t lowest=0;
-
-    // Iterate through all possible cache slots (up to max_size).
-    for(size_t i=0;i<max_size;i++){
-        //check if occupied
-        if(slots[i].isOccupied()){
-            //save the access time of the first occupied slot
-            if(index==-1){
-                lowest=slots[i].getLastAccessTime();
-                index=i;
-            }
-            // If the current slot's access time is lower (older) 
-            // than the current minimum ('lowest'), update the LRU slot index.
-            else if(lowest>slots[i].getLastAccessTime()){
-                lowest=slots[i].getLastAccessTime();
-                index=i;
-            }
-        }
-    }
-    //if the slots are all empty returning the max size
-    if(index==-1){
+    // The tail of the recency list is the least recently used entry
+    if (lru_slot == CacheSlot::NO_SLOT) {
         return max_size;
     }
-    //return the minimum
-    return index;
+    return lru_slot;
 }
 
 size_t LRUCache::findEmptySlot() const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (!slots[i].isOccupied()) return i;
+    // free_slots is a min-heap, so the front is the lowest empty slot
+    if (free_slots.empty()) return max_size;
+    return free_slots.front();
+}
+
+void LRUCache::unlink(size_t slot_idx) {
+    CacheSlot& slot = slots[slot_idx];
+    size_t prev = slot.getPrev();
+    size_t next = slot.getNext();
+
+    if (prev != CacheSlot::NO_SLOT) slots[prev].setNext(next);
+    else mru_slot = next;
+
+    if (next != CacheSlot::NO_SLOT) slots[next].setPrev(prev);
+    else lru_slot = prev;
+
+    slot.setPrev(CacheSlot::NO_SLOT);
+    slot.setNext(CacheSlot::NO_SLOT);
+}
+
+void LRUCache::linkFront(size_t slot_idx) {
+    CacheSlot& slot = slots[slot_idx];
+    slot.setPrev(CacheSlot::NO_SLOT);
+    slot.setNext(mru_slot);
+
+    if (mru_slot != CacheSlot::NO_SLOT) slots[mru_slot].setPrev(slot_idx);
+    mru_slot = slot_idx;
+
+    if (lru_slot == CacheSlot::NO_SLOT) lru_slot = slot_idx;
+}
+
+size_t LRUCache::evictionsNeeded(size_t incoming_bytes, const std::vector<size_t>& victims) const {
+    // Same test as needsEviction(), on the occupancy left after each victim
+    size_t occupied = occupied_count;
+    size_t bytes = used_bytes;
+    size_t count = 0;
+    while (count < victims.size() &&
+           (occupied >= max_size || (max_bytes != 0 && bytes + incoming_bytes > max_bytes))) {
+        bytes -= slots[victims[count]].getBytes();
+        --occupied;
+        ++count;
+    }
+    return count;
+}
+
+bool LRUCache::needsEviction(size_t incoming_bytes) const {
+    if (isFull()) return true;
+    return max_bytes != 0 && used_bytes + incoming_bytes > max_bytes;
+}
+
+void LRUCache::releaseSlot(size_t slot_idx) {
+    if (policy) policy->onRemove(slot_idx);
+    unlink(slot_idx);
+    used_bytes -= slots[slot_idx].getBytes();
+    index.erase(slots[slot_idx].getTrack()->get_title());
+    slots[slot_idx].clear();
+    --occupied_count;
+    free_slots.push_back(slot_idx);
+    std::push_heap(free_slots.begin(), free_slots.end(), std::greater<size_t>());
+}
+
+void LRUCache::rebuildIndex() {
+    index.clear();
+    free_slots.clear();
+    mru_slot = CacheSlot::NO_SLOT;
+    lru_slot = CacheSlot::NO_SLOT;
+    occupied_count = 0;
+    used_bytes = 0;
+
+    // Collect occupied slots ordered from least to most recently used
+    std::vector<size_t> occupied;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].isOccupied()) occupied.push_back(i);
+        else free_slots.push_back(i);
     }
-    return max_size;
+    std::sort(occupied.begin(), occupied.end(), [this](size_t a, size_t b) {
+        return slots[a].getLastAccessTime() < slots[b].getLastAccessTime();
+    });
+
+    // Linking each at the front leaves the most recent one as MRU
+    if (policy) policy->reset(max_size);
+    for (size_t i = 0; i < occupied.size(); ++i) {
+        const std::string& title = slots[occupied[i]].getTrack()->get_title();
+        index[title] = occupied[i];
+        linkFront(occupied[i]);
+        ++occupied_count;
+        used_bytes += slots[occupied[i]].getBytes();
+        if (policy) policy->onInsert(occupied[i], title);
+    }
+    std::make_heap(free_slots.begin(), free_slots.end(), std::greater<size_t>());
 }
 
 void LRUCache::set_capacity(size_t capacity){
@@ -143,4 +247,23 @@ void LRUCache::set_capacity(size_t capacity){
     max_size = capacity;
     //update the slots vector
     slots.resize(capacity);
-}
\ No newline at end of file
+    //slot indices may have been dropped, re-derive the lookup structures
+    rebuildIndex();
+}
+
+void LRUCache::set_byte_budget(size_t bytes) {
+    max_bytes = bytes;
+    // Shrink to the new budget in LRU order
+    while (max_bytes != 0 && used_bytes > max_bytes) {
+        if (!evictLRU()) break;
+    }
+}
+
+void LRUCache::set_policy(PointerWrapper<EvictionPolicy> new_policy) {
+    policy = std::move(new_policy);
+    rebuildIndex();
+}
+
+const char* LRUCache::policyName() const {
+    return policy ? policy->name() : "LRU";
+}
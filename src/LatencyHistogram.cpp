@@ -0,0 +1,102 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+const unsigned LatencyHistogram::SUB_BITS;
+const size_t LatencyHistogram::SUB_BUCKETS;
+const size_t LatencyHistogram::BUCKETS;
+
+LatencyHistogram::LatencyHistogram() : counts(), total(0), sum(0), largest(0) {}
+
+size_t LatencyHistogram::bucket_index(uint64_t ns) {
+    if (ns < 2 * SUB_BUCKETS) {
+        return static_cast<size_t>(ns);
+    }
+    // ns is in [2^msb, 2^(msb + 1)); keep its top SUB_BITS + 1 bits
+    const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+    const unsigned shift = msb - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((ns >> shift) - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucket_high(size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    const unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+    const uint64_t top = SUB_BUCKETS + index % SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;   // wraps to UINT64_MAX for the last bucket
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    counts[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t seen = largest.load(std::memory_order_relaxed);
+    while (ns > seen && !largest.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<uint64_t>& counter : counts) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    largest.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    const uint64_t n = count();
+    return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    const uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * n)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucket_high(i), max());
+        }
+    }
+    return max();   // counters moved on while we read them
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const {
+    Summary result;
+    uint64_t copied[BUCKETS];
+    size_t top = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        copied[i] = counts[i].load(std::memory_order_relaxed);
+        result.count += copied[i];
+        top = copied[i] ? i : top;
+    }
+    if (result.count == 0) {
+        return result;
+    }
+    // record() bumps the bucket before the max, so the max read after the
+    // copy may still lag a value in the top bucket
+    const uint64_t largest_seen = max();
+    const uint64_t top_low = top ? bucket_high(top - 1) + 1 : 0;
+    result.max = largest_seen >= top_low ? std::min(largest_seen, bucket_high(top)) : bucket_high(top);
+    const uint64_t n = count();
+    result.mean = n ? sum.load(std::memory_order_relaxed) / n : 0;
+
+    const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+    uint64_t* targets[] = {&result.p50, &result.p90, &result.p99, &result.p999};
+    for (size_t q = 0; q < 4; ++q) {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantiles[q] * result.count)));
+        uint64_t seen = 0;
+        size_t i = 0;
+        while (seen + copied[i] < rank) {
+            seen += copied[i++];
+        }
+        *targets[q] = std::min(bucket_high(i), result.max);
+    }
+    return result;
+}
@@ -0,0 +1,67 @@
+#include "LibraryAnalyzer.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+const size_t LibraryAnalyzer::GRAIN;
+const size_t LibraryAnalyzer::PROGRESS_STEPS;
+const size_t LibraryAnalyzer::READ_BLOCK;
+
+LibraryAnalyzer::LibraryAnalyzer(size_t threads) : pool(threads) {}
+
+TrackAnalysis LibraryAnalyzer::analyze_track(const AudioTrack& track) {
+    TrackAnalysis result;
+    result.quality = static_cast<float>(track.get_quality_score());
+
+    const WaveformBuffer& waveform = track.get_waveform();
+    double block[READ_BLOCK];
+    double peak = 0.0;
+    double energy = 0.0;
+    for (size_t offset = 0; offset < waveform.size(); offset += READ_BLOCK) {
+        size_t count = std::min(READ_BLOCK, waveform.size() - offset);
+        waveform.read(offset, block, count);
+        for (size_t i = 0; i < count; ++i) {
+            peak = std::max(peak, std::fabs(block[i]));
+            energy += block[i] * block[i];
+        }
+    }
+    result.peak = static_cast<float>(peak);
+    result.rms = waveform.empty() ? 0.0f : static_cast<float>(std::sqrt(energy / waveform.size()));
+
+    result.beatgrid = &track.get_beatgrid();
+    return result;
+}
+
+size_t LibraryAnalyzer::analyze(const std::vector<TrackHandle>& tracks) {
+    const size_t total = tracks.size();
+    std::atomic<size_t> finished(0);
+    std::atomic<size_t> detected(0);
+    std::mutex progress;
+    size_t reported = 0;   // progress steps logged so far, guarded by progress
+
+    pool.parallel_for(total, GRAIN, [&](size_t begin, size_t end) {
+        size_t grids = 0;
+        for (size_t i = begin; i < end; ++i) {
+            AudioTrack& track = *tracks[i];
+            track.set_analysis(analyze_track(track));
+            grids += track.get_analysis()->beatgrid->detected() ? 1 : 0;
+        }
+        detected.fetch_add(grids, std::memory_order_relaxed);
+
+        size_t done = finished.fetch_add(end - begin) + (end - begin);
+        size_t step = done * PROGRESS_STEPS / total;
+        std::lock_guard<std::mutex> guard(progress);
+        if (step > reported) {
+            reported = step;
+            DJ_LOG(Info, Library) << "[INFO] Analyzing library: " << step * 100 / PROGRESS_STEPS << "% ("
+                                  << done << "/" << total << " tracks)" << std::endl;
+        }
+    });
+
+    DJ_LOG(Info, Library) << "[INFO] Library analysis complete: " << total << " tracks, "
+                          << detected.load() << " beat grids detected, " << pool.size()
+                          << (pool.size() == 1 ? " thread" : " threads") << std::endl;
+    return detected.load();
+}
@@ -0,0 +1,86 @@
+#include "LibraryGenerator.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+bool LibraryGenerator::write_config(const std::string& path, const Options& options) {
+    if (options.tracks == 0 || options.min_playlist_length == 0 ||
+        options.min_playlist_length > options.max_playlist_length) {
+        DJ_LOG_ERR(Error, Config) << "[ERROR] Invalid generator options: need tracks > 0 and "
+                                  << "0 < min playlist length <= max playlist length" << std::endl;
+        return false;
+    }
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        DJ_LOG_ERR(Error, Config) << "[ERROR] Could not write config file: " << path << std::endl;
+        return false;
+    }
+
+    std::mt19937_64 rng(options.seed);
+
+    out << "# DJ Track Library Manager\n";
+    out << "# Generated: " << options.tracks << " tracks, " << options.playlists << " playlists, zipf s="
+        << options.zipf_exponent << ", seed " << options.seed << "\n";
+    out << "app_name=DJ Track Library Manager\nversion=2.0\n\n";
+
+    out << "# Track Library Definition\n";
+    for (size_t i = 1; i <= options.tracks; ++i) {
+        bool mp3 = rng() % 3 != 0;
+        int duration = 150 + static_cast<int>(rng() % 450);
+        int bpm = 90 + static_cast<int>(rng() % 80);
+        out << "library_track_" << i << "=" << (mp3 ? "MP3" : "WAV") << ",Generated Track " << i
+            << ",{Artist " << (rng() % (options.tracks / 8 + 1));
+        if (rng() % 4 == 0) out << ";Featured Artist " << (rng() % 500);
+        out << ";}," << duration << "," << bpm << ",";
+        if (mp3) {
+            static const int bitrates[] = {128, 192, 256, 320};
+            out << bitrates[rng() % 4] << "," << (rng() % 2);
+        } else {
+            static const int sample_rates[] = {44100, 48000, 96000};
+            out << sample_rates[rng() % 3] << "," << (rng() % 2 ? 24 : 16);
+        }
+        out << "\n";
+    }
+
+    out << "\n# Cache Settings\ncontroller_cache_size=" << options.cache_size << "\n";
+    out << "\n# Mixing Settings\nbpm_tolerance=10\nauto_sync=true\n";
+
+    // Zipf CDF over popularity ranks: P(rank k) ~ 1 / k^s
+    std::vector<double> cdf(options.tracks);
+    double total = 0;
+    for (size_t k = 0; k < options.tracks; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), options.zipf_exponent);
+        cdf[k] = total;
+    }
+    std::vector<size_t> rank_to_index(options.tracks);
+    for (size_t k = 0; k < options.tracks; ++k) rank_to_index[k] = k + 1;
+    std::shuffle(rank_to_index.begin(), rank_to_index.end(), rng);
+
+    std::uniform_real_distribution<double> unit(0.0, total);
+    std::uniform_int_distribution<size_t> length(options.min_playlist_length, options.max_playlist_length);
+
+    out << "\n# Playlists\n";
+    for (size_t p = 0; p < options.playlists; ++p) {
+        out << "generated_playlist_" << p << "=";
+        size_t entries = length(rng);
+        for (size_t e = 0; e < entries; ++e) {
+            size_t rank = static_cast<size_t>(std::upper_bound(cdf.begin(), cdf.end(), unit(rng)) - cdf.begin());
+            if (rank >= options.tracks) rank = options.tracks - 1;
+            out << (e ? "," : "") << rank_to_index[rank];
+        }
+        out << "\n";
+    }
+
+    out.close();
+    if (!out) {
+        DJ_LOG_ERR(Error, Config) << "[ERROR] Failed while writing config file: " << path << std::endl;
+        return false;
+    }
+    DJ_LOG(Info, Config) << "Generated config: " << path << " (" << options.tracks << " tracks, "
+                         << options.playlists << " playlists)" << std::endl;
+    return true;
+}
@@ -0,0 +1,370 @@
+#include "LibrarySnapshot.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'D', 'J', 'S', 'N', 'A', 'P', '\r', '\n'};
+
+// Range in the string table
+struct StringRange {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct TrackRecord {
+    uint32_t type;               // 0 = MP3, 1 = WAV
+    StringRange title;
+    uint32_t first_artist;       // index into the artist section
+    uint32_t artist_count;
+    int32_t duration_seconds;
+    int32_t bpm;
+    int32_t extra_param1;
+    int32_t extra_param2;
+};
+
+struct PlaylistRecord {
+    StringRange name;
+    uint64_t first_index;        // index into the indices section
+    uint64_t index_count;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+    uint64_t payload_size;
+    uint64_t checksum;
+
+    // Scalar settings
+    int32_t controller_cache_size;
+    int32_t controller_lookahead;
+    int32_t controller_cache_shards;
+    int32_t default_crossfade_time;
+    int32_t bpm_tolerance;
+    uint32_t auto_sync;
+    uint64_t controller_cache_bytes;
+    StringRange app_name;
+    StringRange version_string;
+    StringRange cache_policy;
+    uint32_t reserved[2];        // keeps the counts 8-byte aligned without padding
+
+    // Section sizes, in elements
+    uint64_t track_count;
+    uint64_t artist_count;
+    uint64_t playlist_count;
+    uint64_t index_count;
+    uint64_t string_bytes;
+};
+
+static_assert(sizeof(TrackRecord) == 36, "TrackRecord layout is part of the format");
+static_assert(sizeof(PlaylistRecord) == 24, "PlaylistRecord layout is part of the format");
+static_assert(sizeof(SnapshotHeader) == 160, "SnapshotHeader layout is part of the format");
+
+size_t align8(size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * Section offsets relative to the payload start; payload_size() is the end.
+ */
+struct SectionLayout {
+    size_t tracks;
+    size_t artists;
+    size_t playlists;
+    size_t indices;
+    size_t strings;
+    size_t end;
+
+    explicit SectionLayout(const SnapshotHeader& header)
+        : tracks(0),
+          artists(align8(tracks + header.track_count * sizeof(TrackRecord))),
+          playlists(align8(artists + header.artist_count * sizeof(StringRange))),
+          indices(align8(playlists + header.playlist_count * sizeof(PlaylistRecord))),
+          strings(align8(indices + header.index_count * sizeof(int32_t))),
+          end(align8(strings + header.string_bytes)) {}
+};
+
+/**
+ * 64-bit FNV-1a over 8-byte words, then the tail bytes
+ */
+uint64_t checksum(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    size_t pos = 0;
+    for (; pos + 8 <= size; pos += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + pos, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    for (; pos < size; ++pos) {
+        hash = (hash ^ static_cast<unsigned char>(data[pos])) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool stat_source(const std::string& source_path, SnapshotHeader& header) {
+    struct stat info;
+    if (::stat(source_path.c_str(), &info) != 0) {
+        return false;
+    }
+    header.source_size = static_cast<uint64_t>(info.st_size);
+    header.source_mtime_sec = static_cast<int64_t>(info.st_mtim.tv_sec);
+    header.source_mtime_nsec = static_cast<int64_t>(info.st_mtim.tv_nsec);
+    return true;
+}
+
+/**
+ * Builds the deduplicated string table while the records are collected
+ */
+class StringTableBuilder {
+private:
+    std::string bytes;
+    std::unordered_map<std::string, StringRange> ranges;
+
+public:
+    StringTableBuilder() : bytes(), ranges() {}
+
+    bool add(const std::string& text, StringRange& range) {
+        auto found = ranges.find(text);
+        if (found != ranges.end()) {
+            range = found->second;
+            return true;
+        }
+        if (bytes.size() + text.size() > UINT32_MAX) {
+            return false;
+        }
+        range.offset = static_cast<uint32_t>(bytes.size());
+        range.length = static_cast<uint32_t>(text.size());
+        bytes += text;
+        ranges.emplace(text, range);
+        return true;
+    }
+
+    const std::string& data() const { return bytes; }
+};
+
+}  // namespace
+
+SnapshotTrackTable::SnapshotTrackTable()
+    : file(), tracks(nullptr), artists(nullptr), strings(nullptr), count(0) {}
+
+SnapshotTrackTable::Entry SnapshotTrackTable::track(size_t index) const {
+    const TrackRecord& record = reinterpret_cast<const TrackRecord*>(tracks)[index];
+    Entry entry;
+    entry.wav = record.type == 1;
+    entry.title = StringRef(strings + record.title.offset, record.title.length);
+    entry.artist_count = record.artist_count;
+    entry.duration_seconds = record.duration_seconds;
+    entry.bpm = record.bpm;
+    entry.extra_param1 = record.extra_param1;
+    entry.extra_param2 = record.extra_param2;
+    return entry;
+}
+
+StringRef SnapshotTrackTable::artist(size_t index, size_t artist) const {
+    const TrackRecord& record = reinterpret_cast<const TrackRecord*>(tracks)[index];
+    const StringRange& range = reinterpret_cast<const StringRange*>(artists)[record.first_artist + artist];
+    return StringRef(strings + range.offset, range.length);
+}
+
+bool LibrarySnapshot::write(const std::string& snapshot_path, const std::string& source_path,
+                            const SessionConfig& config) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.header_size = sizeof(SnapshotHeader);
+    if (!stat_source(source_path, header)) {
+        return false;
+    }
+
+    StringTableBuilder strings;
+    bool fits = strings.add(config.app_name, header.app_name) &&
+                strings.add(config.version, header.version_string) &&
+                strings.add(config.cache_policy, header.cache_policy);
+    header.controller_cache_size = config.controller_cache_size;
+    header.controller_lookahead = config.controller_lookahead;
+    header.controller_cache_shards = config.controller_cache_shards;
+    header.default_crossfade_time = config.default_crossfade_time;
+    header.bpm_tolerance = config.bpm_tolerance;
+    header.auto_sync = config.auto_sync ? 1 : 0;
+    header.controller_cache_bytes = config.controller_cache_bytes;
+
+    std::vector<TrackRecord> tracks;
+    std::vector<StringRange> artists;
+    tracks.reserve(config.library_tracks.size());
+    for (const SessionConfig::TrackInfo& info : config.library_tracks) {
+        TrackRecord record;
+        record.type = info.type == "WAV" ? 1 : 0;
+        fits = fits && strings.add(info.title, record.title);
+        record.first_artist = static_cast<uint32_t>(artists.size());
+        record.artist_count = static_cast<uint32_t>(info.artists.size());
+        for (const std::string& artist : info.artists) {
+            StringRange range = {0, 0};
+            fits = fits && strings.add(artist, range);
+            artists.push_back(range);
+        }
+        record.duration_seconds = info.duration_seconds;
+        record.bpm = info.bpm;
+        record.extra_param1 = info.extra_param1;
+        record.extra_param2 = info.extra_param2;
+        tracks.push_back(record);
+    }
+
+    std::vector<PlaylistRecord> playlists;
+    std::vector<int32_t> indices;
+    for (const auto& entry : config.playlists) {
+        PlaylistRecord record;
+        fits = fits && strings.add(entry.first, record.name);
+        record.first_index = indices.size();
+        record.index_count = entry.second.size();
+        indices.insert(indices.end(), entry.second.begin(), entry.second.end());
+        playlists.push_back(record);
+    }
+    if (!fits || artists.size() > UINT32_MAX) {
+        DJ_LOG_ERR(Warn, Config) << "[WARNING] Library too large for a snapshot: " << snapshot_path << std::endl;
+        return false;
+    }
+
+    header.track_count = tracks.size();
+    header.artist_count = artists.size();
+    header.playlist_count = playlists.size();
+    header.index_count = indices.size();
+    header.string_bytes = strings.data().size();
+
+    SectionLayout layout(header);
+    std::vector<char> payload(layout.end, 0);
+    if (!tracks.empty()) std::memcpy(&payload[layout.tracks], tracks.data(), tracks.size() * sizeof(TrackRecord));
+    if (!artists.empty()) std::memcpy(&payload[layout.artists], artists.data(), artists.size() * sizeof(StringRange));
+    if (!playlists.empty()) std::memcpy(&payload[layout.playlists], playlists.data(), playlists.size() * sizeof(PlaylistRecord));
+    if (!indices.empty()) std::memcpy(&payload[layout.indices], indices.data(), indices.size() * sizeof(int32_t));
+    if (!strings.data().empty()) std::memcpy(&payload[layout.strings], strings.data().data(), strings.data().size());
+    header.payload_size = payload.size();
+    header.checksum = checksum(payload.data(), payload.size());
+
+    // Write beside the target and rename, so readers never see a partial file
+    std::string temp_path = snapshot_path + ".tmp";
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        DJ_LOG_ERR(Warn, Config) << "[WARNING] Could not write library snapshot: " << snapshot_path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    out.close();
+    if (!out || std::rename(temp_path.c_str(), snapshot_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        DJ_LOG_ERR(Warn, Config) << "[WARNING] Could not write library snapshot: " << snapshot_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LibrarySnapshot::load(const std::string& snapshot_path, const std::string& source_path,
+                           SessionConfig& config) {
+    std::shared_ptr<SnapshotTrackTable> table = std::make_shared<SnapshotTrackTable>();
+    MappedFile& file = table->file;
+    if (!file.open(snapshot_path) || file.size() < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FORMAT_VERSION || header.header_size != sizeof(SnapshotHeader) ||
+        header.payload_size != file.size() - sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    // Stale if the text config changed since the snapshot was written
+    SnapshotHeader source;
+    if (!stat_source(source_path, source) || source.source_size != header.source_size ||
+        source.source_mtime_sec != header.source_mtime_sec ||
+        source.source_mtime_nsec != header.source_mtime_nsec) {
+        return false;
+    }
+
+    // Counts come from the file: bound them before computing the layout
+    const uint64_t limit = header.payload_size;
+    if (header.track_count > limit || header.artist_count > limit || header.playlist_count > limit ||
+        header.index_count > limit || header.string_bytes > limit) {
+        return false;
+    }
+    SectionLayout layout(header);
+    const char* payload = file.data() + sizeof(SnapshotHeader);
+    if (layout.end != header.payload_size || checksum(payload, header.payload_size) != header.checksum) {
+        return false;
+    }
+
+    const TrackRecord* tracks = reinterpret_cast<const TrackRecord*>(payload + layout.tracks);
+    const StringRange* artists = reinterpret_cast<const StringRange*>(payload + layout.artists);
+    const PlaylistRecord* playlists = reinterpret_cast<const PlaylistRecord*>(payload + layout.playlists);
+    const int32_t* indices = reinterpret_cast<const int32_t*>(payload + layout.indices);
+    const char* strings = payload + layout.strings;
+
+    // A valid checksum does not prove the ranges are sane; check before use
+    auto in_table = [&header](const StringRange& range) {
+        return static_cast<uint64_t>(range.offset) + range.length <= header.string_bytes;
+    };
+    auto text = [strings](const StringRange& range) {
+        return std::string(strings + range.offset, range.length);
+    };
+    if (!in_table(header.app_name) || !in_table(header.version_string) || !in_table(header.cache_policy)) {
+        return false;
+    }
+
+    SessionConfig loaded;
+    loaded.app_name = text(header.app_name);
+    loaded.version = text(header.version_string);
+    loaded.cache_policy = text(header.cache_policy);
+    loaded.controller_cache_size = header.controller_cache_size;
+    loaded.controller_lookahead = header.controller_lookahead;
+    loaded.controller_cache_shards = header.controller_cache_shards;
+    loaded.default_crossfade_time = header.default_crossfade_time;
+    loaded.bpm_tolerance = header.bpm_tolerance;
+    loaded.auto_sync = header.auto_sync != 0;
+    loaded.controller_cache_bytes = static_cast<size_t>(header.controller_cache_bytes);
+
+    // Tracks stay in the mapping; only check that every range can be followed
+    for (uint64_t i = 0; i < header.track_count; ++i) {
+        const TrackRecord& record = tracks[i];
+        if (record.type > 1 || !in_table(record.title) ||
+            static_cast<uint64_t>(record.first_artist) + record.artist_count > header.artist_count) {
+            return false;
+        }
+    }
+    for (uint64_t i = 0; i < header.artist_count; ++i) {
+        if (!in_table(artists[i])) {
+            return false;
+        }
+    }
+    table->tracks = reinterpret_cast<const char*>(tracks);
+    table->artists = reinterpret_cast<const char*>(artists);
+    table->strings = strings;
+    table->count = static_cast<size_t>(header.track_count);
+    loaded.snapshot_tracks = table;
+
+    for (uint64_t i = 0; i < header.playlist_count; ++i) {
+        const PlaylistRecord& record = playlists[i];
+        if (!in_table(record.name) || record.first_index > header.index_count ||
+            record.index_count > header.index_count - record.first_index) {
+            return false;
+        }
+        const int32_t* first = indices + record.first_index;
+        loaded.playlists.emplace_hint(loaded.playlists.end(), text(record.name),
+                                      std::vector<int>(first, first + record.index_count));
+    }
+
+    config = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,231 @@
+#include "Logger.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+/**
+ * Queue node. The queue always holds one consumed "stub" node at the tail.
+ */
+struct LogNode {
+    std::atomic<LogNode*> next;
+    LogStream stream;
+    std::string text;
+
+    LogNode(LogStream stream, std::string&& text) : next(nullptr), stream(stream), text(std::move(text)) {}
+};
+
+/**
+ * Intrusive MPSC queue (Vyukov): producers exchange the head, the single
+ * consumer walks from the tail. Pushing is wait-free.
+ */
+class LogQueue {
+private:
+    std::atomic<LogNode*> head;
+    LogNode* tail;
+
+public:
+    LogQueue() : head(nullptr), tail(new LogNode(LogStream::Out, std::string())) {
+        head.store(tail);
+    }
+    ~LogQueue() {
+        while (LogNode* node = pop()) delete node;
+        delete tail;
+    }
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    void push(LogNode* node) {
+        LogNode* prev = head.exchange(node);
+        prev->next.store(node);
+    }
+
+    /**
+     * @brief Next node in push order, or nullptr; the caller deletes it
+     * The returned node is the old stub carrying the next node's text;
+     * that next node becomes the new stub.
+     */
+    LogNode* pop() {
+        LogNode* next = tail->next.load();
+        if (!next) return nullptr;
+        LogNode* out = tail;
+        out->stream = next->stream;
+        out->text.swap(next->text);
+        out->next.store(nullptr, std::memory_order_relaxed);
+        tail = next;
+        return out;
+    }
+
+    bool empty() const { return tail->next.load() == nullptr; }
+};
+
+struct LoggerState {
+    LogQueue queue;
+    std::thread writer;
+    std::mutex wake_lock;
+    std::condition_variable wake;
+    std::atomic<bool> sleeping;
+    std::atomic<bool> stopping;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> submitted;
+    std::atomic<uint64_t> written;
+    std::mutex drain_lock;
+    std::condition_variable drained;
+    std::mutex sync_lock;            // serializes synchronous writes after shutdown
+
+    LoggerState()
+        : queue(), writer(), wake_lock(), wake(), sleeping(false), stopping(false), running(false),
+          submitted(0), written(0), drain_lock(), drained(), sync_lock() {}
+};
+
+// Never destroyed: lines may still be logged from static destructors
+LoggerState& state() {
+    static LoggerState* instance = new LoggerState();
+    return *instance;
+}
+
+void write_text(LogStream stream, const std::string& text) {
+    if (stream == LogStream::Err) {
+        // std::cerr is tied to std::cout: pending stdout text goes first
+        std::fflush(stdout);
+        std::fwrite(text.data(), 1, text.size(), stderr);
+    } else {
+        std::fwrite(text.data(), 1, text.size(), stdout);
+    }
+}
+
+void writer_loop() {
+    LoggerState& s = state();
+    for (;;) {
+        uint64_t count = 0;
+        while (LogNode* node = s.queue.pop()) {
+            write_text(node->stream, node->text);
+            delete node;
+            ++count;
+        }
+        if (count) {
+            std::fflush(stdout);
+            s.written.fetch_add(count);
+            std::lock_guard<std::mutex> guard(s.drain_lock);
+            s.drained.notify_all();
+            continue;
+        }
+        if (s.stopping.load()) break;
+
+        std::unique_lock<std::mutex> lock(s.wake_lock);
+        s.sleeping.store(true);
+        if (s.queue.empty() && !s.stopping.load()) {
+            s.wake.wait_for(lock, std::chrono::milliseconds(50));
+        }
+        s.sleeping.store(false);
+    }
+}
+
+void wake_writer(LoggerState& s) {
+    if (s.sleeping.load()) {
+        std::lock_guard<std::mutex> guard(s.wake_lock);
+        s.wake.notify_one();
+    }
+}
+
+void start_writer() {
+    LoggerState& s = state();
+    s.running.store(true);
+    s.writer = std::thread(writer_loop);
+    std::atexit(Logger::shutdown);
+}
+
+std::once_flag writer_started;
+
+// Bits 0..threshold of one category's nibble
+constexpr uint64_t levels_up_to(LogLevel threshold) {
+    return (uint64_t(1) << (static_cast<unsigned>(threshold) + 1)) - 1;
+}
+
+// The same nibble for the first `categories` categories
+constexpr uint64_t mask_for(LogLevel threshold,
+                            unsigned categories = static_cast<unsigned>(LogCategory::Count)) {
+    return categories == 0 ? 0 : (mask_for(threshold, categories - 1) << 4) | levels_up_to(threshold);
+}
+
+}  // namespace
+
+// Constant-initialized, so lines logged during static initialization are not dropped
+std::atomic<uint64_t> Logger::enabled_mask(mask_for(LogLevel::Info));
+
+void Logger::set_level(LogLevel threshold) {
+    enabled_mask.store(mask_for(threshold));
+}
+
+void Logger::set_category_level(LogCategory category, LogLevel threshold) {
+    unsigned shift = static_cast<unsigned>(category) * 4;
+    uint64_t mask = enabled_mask.load();
+    mask = (mask & ~(uint64_t(0xF) << shift)) | (levels_up_to(threshold) << shift);
+    enabled_mask.store(mask);
+}
+
+void Logger::set_quiet(bool quiet) {
+    set_level(quiet ? LogLevel::Error : LogLevel::Info);
+}
+
+void Logger::submit(LogStream stream, std::string&& text) {
+    if (text.empty()) return;
+    std::call_once(writer_started, start_writer);
+    LoggerState& s = state();
+    if (!s.running.load()) {
+        std::lock_guard<std::mutex> guard(s.sync_lock);
+        write_text(stream, text);
+        std::fflush(stdout);
+        return;
+    }
+    s.queue.push(new LogNode(stream, std::move(text)));
+    s.submitted.fetch_add(1);
+    wake_writer(s);
+}
+
+void Logger::flush() {
+    LoggerState& s = state();
+    if (!s.running.load()) {
+        std::fflush(stdout);
+        return;
+    }
+    uint64_t target = s.submitted.load();
+    {
+        std::lock_guard<std::mutex> guard(s.wake_lock);
+        s.wake.notify_one();
+    }
+    std::unique_lock<std::mutex> lock(s.drain_lock);
+    s.drained.wait(lock, [&s, target]() { return s.written.load() >= target; });
+}
+
+void Logger::shutdown() {
+    LoggerState& s = state();
+    if (!s.running.load()) return;
+    {
+        std::lock_guard<std::mutex> guard(s.wake_lock);
+        s.stopping.store(true);
+        s.wake.notify_one();
+    }
+    s.writer.join();
+    s.running.store(false);
+    std::fflush(stdout);
+}
+
+LogLine& LogLine::operator<<(double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.*g", 6, value);
+    if (length > 0) text.append(buffer, static_cast<size_t>(length));
+    return *this;
+}
+
+LogLine& LogLine::operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+    typedef std::ostream& (*Manipulator)(std::ostream&);
+    if (manipulator == static_cast<Manipulator>(std::endl)) {
+        text += '\n';
+    }
+    return *this;
+}
@@ -1,5 +1,5 @@
 #include "MP3Track.h"
-#include <iostream>
+#include "Logger.h"
 #include <cmath>
 #include <algorithm>
 
@@ -7,33 +7,35 @@ MP3Track::MP3Track(const std::string& title, const std::vector<std::string>& art
                    int duration, int bpm, int bitrate, bool has_tags)
     : AudioTrack(title, artists, duration, bpm), bitrate(bitrate), has_id3_tags(has_tags) {
 
-    std::cout << "MP3Track created: " << bitrate << " kbps" << std::endl;
+    DJ_LOG(Info, Track) << "MP3Track created: " << bitrate << " kbps" << std::endl;
 }
 
 // ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
 
 void MP3Track::load() {
-    std::cout << "[MP3Track::load] Loading MP3: \"" << title
+    DJ_LOG(Info, Track) << "[MP3Track::load] Loading MP3: \"" << title
               << "\" at " << bitrate << " kbps...\n";
     // TODO: Implement MP3 loading with format-specific operations
     // NOTE: Use exactly 2 spaces before the arrow (→) character
     if(has_id3_tags){
-     std::cout << "  → Processing ID3 metadata (artist info, album art, etc.)... \n";
+     DJ_LOG(Info, Track) << "  → Processing ID3 metadata (artist info, album art, etc.)... \n";
     }
     else{
-        std::cout << "  → No ID3 tags found: \n";
+        DJ_LOG(Info, Track) << "  → No ID3 tags found: \n";
     }
-    std::cout << "  → Decoding MP3 frames... \n";
-    std::cout << "  → Load complete. \n";
+    DJ_LOG(Info, Track) << "  → Decoding MP3 frames... \n";
+    DJ_LOG(Info, Track) << "  → Load complete. \n";
 }
 
 void MP3Track::analyze_beatgrid() {
     // TODO: Implement MP3-specific beat detection analysis
     // NOTE: Use exactly 2 spaces before each arrow (→) character
-    std::cout << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n"; 
+    DJ_LOG(Info, Track) << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n"; 
     double beats = (duration_seconds / 60.0)*bpm;
     double precision_factor = bitrate/320.0;
-    std::cout << "  → Estimated beats: " << int(beats) <<  "  → Compression precision factor:" << precision_factor << "\n";
+    DJ_LOG(Info, Track) << "  → Estimated beats: " << int(beats) <<  "  → Compression precision factor:" << precision_factor << "\n";
+    get_beatgrid();   // tracked once per waveform, then served from the analysis cache
+    DJ_LOG(Debug, Track) << "  → " << describe_beatgrid() << "\n";   // shown with --beatgrids
 
 }
 
@@ -57,6 +59,6 @@ double MP3Track::get_quality_score() const {
 
 PointerWrapper<AudioTrack> MP3Track::clone() const {
     // Creates a new MP3 object using the MP3 Copy Constructor.
-    // The base class AudioTrack's deep copy logic ensures waveform_data is copied.
+    // The base class AudioTrack's copy shares the waveform (copy-on-write).
     return PointerWrapper<AudioTrack>(new MP3Track(*this)); 
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : mapping(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap rejects zero-length mappings; an empty file is simply an empty view
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps its own reference to the file
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    ::madvise(address, size, MADV_SEQUENTIAL);
+
+    mapping = address;
+    length = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping) {
+        ::munmap(mapping, length);
+    }
+    mapping = nullptr;
+    length = 0;
+}
@@ -0,0 +1,278 @@
+#include "MixKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DJ_MIX_X86 1
+// GCC 12 warns about the deliberately undefined pass-through operand inside
+// the AVX-512 intrinsics (-O2 only); nothing in this file relies on it
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// ========== SCALAR REFERENCE ==========
+
+inline float clamp_sample(float sample, float low, float high) {
+    // Same comparisons as max_ps(sample, low) then min_ps(.., high)
+    sample = sample > low ? sample : low;
+    return sample < high ? sample : high;
+}
+
+void store_stereo_scalar(float* out, const double* in, float gain, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        float sample = gain * static_cast<float>(in[i]);
+        out[2 * i] = sample;
+        out[2 * i + 1] = sample;
+    }
+}
+
+void add_stereo_scalar(float* out, const double* in, float gain, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        float sample = gain * static_cast<float>(in[i]);
+        out[2 * i] += sample;
+        out[2 * i + 1] += sample;
+    }
+}
+
+void mix2_stereo_scalar(float* out, const double* in0, float gain0, const double* in1, float gain1,
+                        size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        float sample = gain0 * static_cast<float>(in0[i]) + gain1 * static_cast<float>(in1[i]);
+        out[2 * i] = sample;
+        out[2 * i + 1] = sample;
+    }
+}
+
+void clip_scalar(float* samples, size_t count, float limit) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = clamp_sample(samples[i], -limit, limit);
+    }
+}
+
+const MixKernels SCALAR = {SimdLevel::Scalar, store_stereo_scalar, add_stereo_scalar, mix2_stereo_scalar,
+                           clip_scalar};
+
+#ifdef DJ_MIX_X86
+
+// ========== SSE2: 4 frames per step ==========
+
+__attribute__((target("sse2"))) inline __m128 load4_sse2(const double* in) {
+    return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(in)), _mm_cvtpd_ps(_mm_loadu_pd(in + 2)));
+}
+
+__attribute__((target("sse2"))) inline void store4_stereo_sse2(float* out, __m128 samples) {
+    _mm_storeu_ps(out, _mm_unpacklo_ps(samples, samples));
+    _mm_storeu_ps(out + 4, _mm_unpackhi_ps(samples, samples));
+}
+
+__attribute__((target("sse2")))
+void store_stereo_sse2(float* out, const double* in, float gain, size_t frames) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        store4_stereo_sse2(out + 2 * i, _mm_mul_ps(g, load4_sse2(in + i)));
+    }
+    store_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("sse2")))
+void add_stereo_sse2(float* out, const double* in, float gain, size_t frames) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 samples = _mm_mul_ps(g, load4_sse2(in + i));
+        float* dst = out + 2 * i;
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_unpacklo_ps(samples, samples)));
+        _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_loadu_ps(dst + 4), _mm_unpackhi_ps(samples, samples)));
+    }
+    add_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("sse2")))
+void mix2_stereo_sse2(float* out, const double* in0, float gain0, const double* in1, float gain1,
+                      size_t frames) {
+    const __m128 g0 = _mm_set1_ps(gain0);
+    const __m128 g1 = _mm_set1_ps(gain1);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 samples = _mm_add_ps(_mm_mul_ps(g0, load4_sse2(in0 + i)), _mm_mul_ps(g1, load4_sse2(in1 + i)));
+        store4_stereo_sse2(out + 2 * i, samples);
+    }
+    mix2_stereo_scalar(out + 2 * i, in0 + i, gain0, in1 + i, gain1, frames - i);
+}
+
+__attribute__((target("sse2")))
+void clip_sse2(float* samples, size_t count, float limit) {
+    const __m128 low = _mm_set1_ps(-limit);
+    const __m128 high = _mm_set1_ps(limit);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), low), high));
+    }
+    clip_scalar(samples + i, count - i, limit);
+}
+
+const MixKernels SSE2 = {SimdLevel::SSE2, store_stereo_sse2, add_stereo_sse2, mix2_stereo_sse2, clip_sse2};
+
+// ========== AVX2: 4 frames (8 output floats) per vector ==========
+
+__attribute__((target("avx2"))) inline __m128 load4_avx2(const double* in) {
+    return _mm256_cvtpd_ps(_mm256_loadu_pd(in));
+}
+
+// [a b c d] -> [a a b b c c d d]
+__attribute__((target("avx2"))) inline __m256 duplicate_avx2(__m128 samples) {
+    return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(samples), _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3));
+}
+
+__attribute__((target("avx2")))
+void store_stereo_avx2(float* out, const double* in, float gain, size_t frames) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        _mm256_storeu_ps(out + 2 * i, duplicate_avx2(_mm_mul_ps(g, load4_avx2(in + i))));
+    }
+    store_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("avx2")))
+void add_stereo_avx2(float* out, const double* in, float gain, size_t frames) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float* dst = out + 2 * i;
+        __m256 samples = duplicate_avx2(_mm_mul_ps(g, load4_avx2(in + i)));
+        _mm256_storeu_ps(dst, _mm256_add_ps(_mm256_loadu_ps(dst), samples));
+    }
+    add_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("avx2")))
+void mix2_stereo_avx2(float* out, const double* in0, float gain0, const double* in1, float gain1,
+                      size_t frames) {
+    const __m128 g0 = _mm_set1_ps(gain0);
+    const __m128 g1 = _mm_set1_ps(gain1);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 samples = _mm_add_ps(_mm_mul_ps(g0, load4_avx2(in0 + i)), _mm_mul_ps(g1, load4_avx2(in1 + i)));
+        _mm256_storeu_ps(out + 2 * i, duplicate_avx2(samples));
+    }
+    mix2_stereo_scalar(out + 2 * i, in0 + i, gain0, in1 + i, gain1, frames - i);
+}
+
+__attribute__((target("avx2")))
+void clip_avx2(float* samples, size_t count, float limit) {
+    const __m256 low = _mm256_set1_ps(-limit);
+    const __m256 high = _mm256_set1_ps(limit);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(samples + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(samples + i), low), high));
+    }
+    clip_scalar(samples + i, count - i, limit);
+}
+
+const MixKernels AVX2 = {SimdLevel::AVX2, store_stereo_avx2, add_stereo_avx2, mix2_stereo_avx2, clip_avx2};
+
+// ========== AVX-512: 8 frames (16 output floats) per vector ==========
+
+__attribute__((target("avx512f"))) inline __m256 load8_avx512(const double* in) {
+    return _mm512_cvtpd_ps(_mm512_loadu_pd(in));
+}
+
+// [a b c d e f g h] -> [a a b b ... h h]
+__attribute__((target("avx512f"))) inline __m512 duplicate_avx512(__m256 samples) {
+    const __m512i pairs = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    return _mm512_permutexvar_ps(pairs, _mm512_castps256_ps512(samples));
+}
+
+__attribute__((target("avx512f")))
+void store_stereo_avx512(float* out, const double* in, float gain, size_t frames) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        _mm512_storeu_ps(out + 2 * i, duplicate_avx512(_mm256_mul_ps(g, load8_avx512(in + i))));
+    }
+    store_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("avx512f")))
+void add_stereo_avx512(float* out, const double* in, float gain, size_t frames) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        float* dst = out + 2 * i;
+        __m512 samples = duplicate_avx512(_mm256_mul_ps(g, load8_avx512(in + i)));
+        _mm512_storeu_ps(dst, _mm512_add_ps(_mm512_loadu_ps(dst), samples));
+    }
+    add_stereo_scalar(out + 2 * i, in + i, gain, frames - i);
+}
+
+__attribute__((target("avx512f")))
+void mix2_stereo_avx512(float* out, const double* in0, float gain0, const double* in1, float gain1,
+                        size_t frames) {
+    const __m256 g0 = _mm256_set1_ps(gain0);
+    const __m256 g1 = _mm256_set1_ps(gain1);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 samples = _mm256_add_ps(_mm256_mul_ps(g0, load8_avx512(in0 + i)),
+                                       _mm256_mul_ps(g1, load8_avx512(in1 + i)));
+        _mm512_storeu_ps(out + 2 * i, duplicate_avx512(samples));
+    }
+    mix2_stereo_scalar(out + 2 * i, in0 + i, gain0, in1 + i, gain1, frames - i);
+}
+
+__attribute__((target("avx512f")))
+void clip_avx512(float* samples, size_t count, float limit) {
+    const __m512 low = _mm512_set1_ps(-limit);
+    const __m512 high = _mm512_set1_ps(limit);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(samples + i, _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(samples + i), low), high));
+    }
+    clip_scalar(samples + i, count - i, limit);
+}
+
+const MixKernels AVX512 = {SimdLevel::AVX512, store_stereo_avx512, add_stereo_avx512, mix2_stereo_avx512,
+                           clip_avx512};
+
+#endif  // DJ_MIX_X86
+
+}  // namespace
+
+SimdLevel MixKernels::detected_level() {
+#ifdef DJ_MIX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+const MixKernels* MixKernels::for_level(SimdLevel level) {
+    if (level > detected_level()) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DJ_MIX_X86
+    case SimdLevel::AVX512: return &AVX512;
+    case SimdLevel::AVX2: return &AVX2;
+    case SimdLevel::SSE2: return &SSE2;
+#endif
+    default: return &SCALAR;
+    }
+}
+
+const MixKernels& MixKernels::active() {
+    static const MixKernels* const kernels = for_level(detected_level());
+    return *kernels;
+}
+
+const char* MixKernels::level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::SSE2: return "sse2";
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    default: return "scalar";
+    }
+}
@@ -1,27 +1,57 @@
 #include "MixingEngineService.h"
-#include <iostream>
+#include "Logger.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
 #include <memory>
 
+const size_t MixingEngineService::MAX_BLOCK_FRAMES;
+const size_t MixingEngineService::OUTPUT_CHANNELS;
+const size_t MixingEngineService::COMMAND_QUEUE;
+
+namespace {
+const double HALF_PI = 1.57079632679489661923;
+
+// How long the render thread sleeps when its output ring is full
+const std::chrono::microseconds RENDER_IDLE(200);
+}
+
 
 /**
  * TODO: Implement MixingEngineService constructor
  */
 MixingEngineService::MixingEngineService()
-    : decks(), active_deck(1), auto_sync(false), bpm_tolerance(0)
+    : decks(), active_deck(1), auto_sync(false), bpm_tolerance(0),
+      deck_gain(), crossfader(0.5f), crossfader_gain(), rendering(false), deck_native_bpm(), deck_tempo(),
+      deck_samples(), deck_length(), deck_position(), mix_gain(), render_tempo(),
+      kernels(&MixKernels::active()), stretchers(),
+      stretch_output{std::vector<double>(MAX_BLOCK_FRAMES), std::vector<double>(MAX_BLOCK_FRAMES)},
+      commands(), output(), render_buffer(), render_thread(), render_running(false),
+      commands_posted(0), commands_applied(0), published_position(), blocks_rendered(0),
+      render_block_frames(0), block_deadline_ns(0), render_times(), deadline_misses(0), underruns(0), retired(),
+      preload_worker(), preload_done(), preload_title(), staged_track()
 {
     decks[0] = nullptr;
     decks[1] = nullptr;
     auto_sync = false;
     bpm_tolerance = 0; // default tolerance
+    deck_gain[0] = deck_gain[1] = 1.0f;
+    deck_tempo[0] = deck_tempo[1] = 1.0;
+    render_tempo[0] = render_tempo[1] = 1.0;
+    setCrossfader(0.5f);
 
-    std::cout << "[MixingEngineService] Initialized with 2 empty decks." << std::endl;
+    DJ_LOG(Info, Mixer) << "[MixingEngineService] Initialized with 2 empty decks." << std::endl;
 }
 
 /**
  * TODO: Implement MixingEngineService destructor
  */
 MixingEngineService::~MixingEngineService() {
-    std::cout << "[MixingEngineService] Cleaning up decks...." << std::endl;
+    DJ_LOG(Info, Mixer) << "[MixingEngineService] Cleaning up decks...." << std::endl;
+    stopRenderThread();
+    cancelPreload();
 
     for(int i = 0; i < 2; i++){
         if(decks[i] != nullptr){
@@ -39,6 +69,9 @@ MixingEngineService::~MixingEngineService() {
  * @return: Index of the deck where track was loaded, or -1 on failure
  */
 int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
+    // Wait for a pending preload first, so its log lines come before ours
+    PointerWrapper<AudioTrack> preloaded = take_preloaded(track.get_title());
+
     size_t load_index;
     // (d) Identify target deck:
     if (decks[0] == nullptr && decks[1] == nullptr) {
@@ -50,59 +83,415 @@ int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
     }
 
     // (a) Log start
-    std::cout << "\n=== Loading Track to Deck ===" << std::endl;
-    std::cout << "[Deck Switch] Target deck: " << load_index << std::endl;
+    DJ_LOG(Info, Mixer) << "\n=== Loading Track to Deck ===" << std::endl;
+    DJ_LOG(Info, Mixer) << "[Deck Switch] Target deck: " << load_index << std::endl;
 
 
-    // (b) Clone track polymorphically
-    PointerWrapper<AudioTrack> cloned_track = track.clone();
+    // (b) Clone track polymorphically (already done if it was preloaded)
+    bool was_preloaded = static_cast<bool>(preloaded);
+    PointerWrapper<AudioTrack> cloned_track = was_preloaded ? std::move(preloaded) : track.clone();
 
     // (c) Check for clone failure
     if (!cloned_track) {
-        std::cerr << "[ERROR] Track: "" << track.get_title() << "" failed to clone." << std::endl;
+        DJ_LOG_ERR(Error, Mixer) << "[ERROR] Track: "" << track.get_title() << "" failed to clone." << std::endl;
         return -1;
     }
 
     // (e) Unload target deck if occupied
     if (decks[load_index] != nullptr) {
-        delete decks[load_index];
+        AudioTrack* unloaded = decks[load_index];
         decks[load_index] = nullptr;
+        bind_deck(load_index);
+        retire(unloaded);
     }
     // (f) Perform track preparation 
-    cloned_track->load();
-    cloned_track->analyze_beatgrid();
+    if (was_preloaded) {
+        DJ_LOG(Info, Mixer) << "[Preload] Using preloaded '" << cloned_track->get_title() << "'" << std::endl;
+    } else {
+        cloned_track->load();
+        cloned_track->analyze_beatgrid();
+    }
 
     // (g) BPM management - auto sync if enabled and mixable
+    const int native_bpm = cloned_track->get_bpm();
+    double synced_bpm = 0.0;
     if (auto_sync && can_mix_tracks(cloned_track)) {
         sync_bpm(cloned_track);
+        // The stored bpm is a truncated average; the deck plays at the exact one
+        synced_bpm = (getDeckBpm(active_deck) + native_bpm) / 2.0;
     }
 
     // (h) Assign track to target deck
     decks[load_index] = cloned_track.release();
-    std::cout << "[Load Complete] '" << decks[load_index]->get_title() << "' is now loaded on deck " << load_index << std::endl;
+    bind_deck(load_index);
+    deck_native_bpm[load_index] = native_bpm;
+    if (synced_bpm > 0.0 && native_bpm > 0) {
+        setDeckTempo(load_index, synced_bpm / native_bpm);
+    }
+    DJ_LOG(Info, Mixer) << "[Load Complete] '" << decks[load_index]->get_title() << "' is now loaded on deck " << load_index << std::endl;
 
     // (i) Switch active deck
     active_deck = load_index;
 
 
-    std::cout << "[Active Deck] Switched to deck " << active_deck << std::endl;
+    DJ_LOG(Info, Mixer) << "[Active Deck] Switched to deck " << active_deck << std::endl;
 
     return load_index; 
 }
 
+bool MixingEngineService::preloadTrack(const TrackHandle& track) {
+    if (!track) {
+        return false;
+    }
+    cancelPreload();
+    if (!preload_worker) {
+        preload_worker.reset(new ThreadPool(1));
+    }
+
+    preload_title = track->get_title();
+    DJ_LOG(Info, Mixer) << "[Preload] Preparing '" << preload_title << "' for the inactive deck" << std::endl;
+    const bool warm_samples = rendering;
+    preload_done = preload_worker->submit([this, track, warm_samples]() {
+        PointerWrapper<AudioTrack> cloned = track->clone();
+        if (cloned) {
+            cloned->load();
+            cloned->analyze_beatgrid();
+            if (warm_samples) {
+                cloned->get_waveform_data();   // generate lazy samples off the transition path
+            }
+        }
+        staged_track = std::move(cloned);
+    });
+    return true;
+}
+
+void MixingEngineService::cancelPreload() {
+    if (preload_done.valid()) {
+        preload_done.wait();
+        preload_done = std::future<void>();
+    }
+    staged_track.reset();
+    preload_title.clear();
+}
+
+PointerWrapper<AudioTrack> MixingEngineService::take_preloaded(const std::string& track_title) {
+    PointerWrapper<AudioTrack> taken;
+    if (!preload_done.valid() || preload_title != track_title) {
+        return taken;
+    }
+    try {
+        preload_done.get();
+        taken = std::move(staged_track);
+    } catch (const std::exception& e) {
+        DJ_LOG_ERR(Error, Mixer) << "[ERROR] Preload of '" << track_title << "' failed: " << e.what() << std::endl;
+    }
+    cancelPreload();
+    return taken;
+}
+
+void MixingEngineService::bind_deck(size_t deck) {
+    deck_native_bpm[deck] = decks[deck] ? decks[deck]->get_bpm() : 0;
+    deck_tempo[deck] = 1.0;
+    MixCommand command;
+    command.type = MixCommand::LOAD_DECK;
+    command.deck = deck;
+    // Generates lazy samples here (preloaded tracks already have them)
+    command.samples = rendering && decks[deck] ? decks[deck]->get_waveform_data() : nullptr;
+    command.length = command.samples ? decks[deck]->get_waveform_size() : 0;
+    post(command);
+}
+
+void MixingEngineService::bind_samples(size_t deck) {
+    MixCommand command;
+    command.type = MixCommand::BIND_SAMPLES;
+    command.deck = deck;
+    command.samples = rendering && decks[deck] ? decks[deck]->get_waveform_data() : nullptr;
+    command.length = command.samples ? decks[deck]->get_waveform_size() : 0;
+    post(command);
+}
+
+void MixingEngineService::post_gains() {
+    MixCommand command;
+    command.type = MixCommand::SET_GAINS;
+    command.gains[0] = deck_gain[0] * crossfader_gain[0];
+    command.gains[1] = deck_gain[1] * crossfader_gain[1];
+    post(command);
+}
+
+void MixingEngineService::post(const MixCommand& command) {
+    if (!render_thread.joinable()) {
+        apply(command);
+        return;
+    }
+    // The render thread drains commands even while its output is full
+    while (!commands->push(command)) {
+        std::this_thread::yield();
+    }
+    ++commands_posted;
+    reclaim_retired();
+}
+
+void MixingEngineService::apply(const MixCommand& command) {
+    const size_t deck = command.deck;
+    switch (command.type) {
+    case MixCommand::LOAD_DECK:
+        deck_position[deck] = 0;
+        render_tempo[deck] = 1.0;
+        apply_samples(deck, command.samples, command.length);
+        break;
+    case MixCommand::BIND_SAMPLES:
+        apply_samples(deck, command.samples, command.length);
+        break;
+    case MixCommand::SET_GAINS:
+        mix_gain[0] = command.gains[0];
+        mix_gain[1] = command.gains[1];
+        break;
+    case MixCommand::SET_POSITION:
+        deck_position[deck] = std::min(command.length, deck_length[deck]);
+        if (render_tempo[deck] != 1.0) {
+            stretchers[deck].reset(deck_samples[deck], deck_length[deck], static_cast<double>(deck_position[deck]));
+        }
+        break;
+    case MixCommand::SET_TEMPO: {
+        const bool was_stretching = render_tempo[deck] != 1.0;
+        stretchers[deck].set_ratio(command.tempo);
+        render_tempo[deck] = command.tempo;
+        if (render_tempo[deck] != 1.0 && !was_stretching) {
+            stretchers[deck].reset(deck_samples[deck], deck_length[deck], static_cast<double>(deck_position[deck]));
+        }
+        break;
+    }
+    }
+    published_position[deck].store(deck_position[deck], std::memory_order_relaxed);
+}
+
+void MixingEngineService::apply_samples(size_t deck, const double* samples, size_t length) {
+    deck_samples[deck] = samples;
+    deck_length[deck] = samples ? length : 0;
+    deck_position[deck] = std::min(deck_position[deck], deck_length[deck]);
+    if (render_tempo[deck] != 1.0) {
+        stretchers[deck].reset(deck_samples[deck], deck_length[deck], static_cast<double>(deck_position[deck]));
+    }
+}
+
+void MixingEngineService::retire(AudioTrack* track) {
+    if (render_thread.joinable()) {
+        retired.push_back(std::make_pair(commands_posted, track));
+    } else {
+        delete track;
+    }
+}
+
+void MixingEngineService::reclaim_retired() {
+    const uint64_t applied = commands_applied.load(std::memory_order_acquire);
+    auto done = std::partition(retired.begin(), retired.end(),
+                               [applied](const std::pair<uint64_t, AudioTrack*>& entry) { return entry.first > applied; });
+    for (auto it = done; it != retired.end(); ++it) {
+        delete it->second;
+    }
+    retired.erase(done, retired.end());
+}
+
+void MixingEngineService::setRenderingEnabled(bool enabled) {
+    rendering = enabled;
+    bind_samples(0);
+    bind_samples(1);
+}
+
+void MixingEngineService::startRenderThread(size_t block_frames, size_t queued_blocks, double sample_rate) {
+    if (render_thread.joinable()) {
+        return;
+    }
+    block_frames = std::max<size_t>(1, std::min(block_frames, MAX_BLOCK_FRAMES));
+    const size_t block_samples = block_frames * OUTPUT_CHANNELS;
+    commands.reset(new SpscRing<MixCommand>(COMMAND_QUEUE));
+    output.reset(new SpscRing<float>(block_samples * std::max<size_t>(queued_blocks, 1)));
+    render_buffer.assign(block_samples, 0.0f);
+    commands_posted = 0;
+    commands_applied.store(0, std::memory_order_relaxed);
+    blocks_rendered.store(0, std::memory_order_relaxed);
+    render_block_frames = block_frames;
+    block_deadline_ns = sample_rate > 0.0 ? static_cast<uint64_t>(block_frames * 1e9 / sample_rate) : 0;
+    render_times.reset();
+    deadline_misses.store(0, std::memory_order_relaxed);
+    underruns.store(0, std::memory_order_relaxed);
+    for (size_t d = 0; d < 2; ++d) {
+        published_position[d].store(deck_position[d], std::memory_order_relaxed);
+    }
+    render_running.store(true, std::memory_order_release);
+    render_thread = std::thread(&MixingEngineService::render_loop, this);
+}
+
+void MixingEngineService::stopRenderThread() {
+    if (!render_thread.joinable()) {
+        return;
+    }
+    render_running.store(false, std::memory_order_release);
+    render_thread.join();
+    // The render state is ours again: finish what was queued
+    MixCommand command;
+    while (commands->pop(command)) {
+        apply(command);
+    }
+    for (const auto& entry : retired) {
+        delete entry.second;
+    }
+    retired.clear();
+    commands.reset();
+    output.reset();
+    render_buffer.clear();
+}
+
+size_t MixingEngineService::readRenderedFrames(float* out, size_t frames) {
+    if (!render_thread.joinable()) {
+        return 0;
+    }
+    reclaim_retired();
+    // The render thread queues whole blocks, so the ring always holds whole frames
+    const size_t read = output->pop(out, frames * OUTPUT_CHANNELS) / OUTPUT_CHANNELS;
+    if (read < frames) {
+        underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    return read;
+}
+
+MixingEngineService::RenderTelemetry MixingEngineService::getRenderTelemetry() const {
+    RenderTelemetry telemetry;
+    // The render thread records a block's time before counting its miss, so
+    // reading the misses first keeps them within the blocks summarized
+    telemetry.deadline_misses = deadline_misses.load(std::memory_order_relaxed);
+    telemetry.underruns = underruns.load(std::memory_order_relaxed);
+    telemetry.render_ns = render_times.summary();
+    telemetry.block_frames = render_block_frames;
+    telemetry.deadline_ns = block_deadline_ns;
+    return telemetry;
+}
+
+void MixingEngineService::render_loop() {
+    const size_t block_frames = render_buffer.size() / OUTPUT_CHANNELS;
+    uint64_t applied = 0;
+    MixCommand command;
+    while (render_running.load(std::memory_order_acquire)) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        // Block boundary: take every pending change before rendering on
+        while (commands->pop(command)) {
+            apply(command);
+            commands_applied.store(++applied, std::memory_order_release);
+        }
+        if (output->free_space() < render_buffer.size()) {
+            std::this_thread::sleep_for(RENDER_IDLE);
+            continue;
+        }
+        renderBlock(render_buffer.data(), block_frames);
+        const uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        render_times.record(elapsed);
+        if (elapsed > block_deadline_ns) {
+            deadline_misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        output->push(render_buffer.data(), render_buffer.size());
+        for (size_t d = 0; d < 2; ++d) {
+            published_position[d].store(deck_position[d], std::memory_order_relaxed);
+        }
+        blocks_rendered.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+size_t MixingEngineService::renderBlock(float* out, size_t frames) {
+    frames = std::min(frames, MAX_BLOCK_FRAMES);
+    const float gain0 = mix_gain[0];
+    const float gain1 = mix_gain[1];
+
+    // Each deck's next samples: straight from the waveform, or time-stretched
+    size_t avail[2];
+    const double* in[2];
+    for (size_t d = 0; d < 2; ++d) {
+        if (render_tempo[d] != 1.0) {
+            avail[d] = stretchers[d].process(stretch_output[d].data(), frames);
+            in[d] = stretch_output[d].data();
+            deck_position[d] = static_cast<size_t>(stretchers[d].position());
+        } else {
+            avail[d] = std::min(frames, deck_length[d] - deck_position[d]);
+            in[d] = deck_samples[d] + (avail[d] ? deck_position[d] : 0);
+            deck_position[d] += avail[d];
+        }
+    }
+    const size_t avail0 = avail[0], avail1 = avail[1];
+    const double* in0 = in[0];
+    const double* in1 = in[1];
+
+    // Both decks, then whichever deck still has samples, then silence
+    const size_t both = std::min(avail0, avail1);
+    kernels->mix2_stereo(out, in0, gain0, in1, gain1, both);
+    if (avail0 > both) {
+        kernels->store_stereo(out + 2 * both, in0 + both, gain0, avail0 - both);
+    } else if (avail1 > both) {
+        kernels->store_stereo(out + 2 * both, in1 + both, gain1, avail1 - both);
+    }
+    const size_t written = std::max(avail0, avail1);
+    std::fill(out + 2 * written, out + 2 * frames, 0.0f);
+    kernels->clip(out, 2 * written, 1.0f);
+    return frames;
+}
+
+void MixingEngineService::setDeckGain(size_t deck, float gain) {
+    if (deck < 2) {
+        deck_gain[deck] = gain > 0.0f ? gain : 0.0f;   // also maps NaN to 0
+        post_gains();
+    }
+}
+
+void MixingEngineService::setCrossfader(float position) {
+    crossfader = position > 0.0f ? std::min(position, 1.0f) : 0.0f;
+    const double angle = crossfader * HALF_PI;
+    // cos(pi/2) is not exactly 0: fully over, the other deck must be silent
+    crossfader_gain[0] = crossfader < 1.0f ? static_cast<float>(std::cos(angle)) : 0.0f;
+    crossfader_gain[1] = static_cast<float>(std::sin(angle));
+    post_gains();
+}
+
+size_t MixingEngineService::getDeckPosition(size_t deck) const {
+    if (deck >= 2) {
+        return 0;
+    }
+    return render_thread.joinable() ? published_position[deck].load(std::memory_order_relaxed) : deck_position[deck];
+}
+
+void MixingEngineService::setDeckPosition(size_t deck, size_t position) {
+    if (deck < 2) {
+        MixCommand command;
+        command.type = MixCommand::SET_POSITION;
+        command.deck = deck;
+        command.length = position;
+        post(command);
+    }
+}
+
+void MixingEngineService::setDeckTempo(size_t deck, double tempo) {
+    if (deck >= 2 || !decks[deck]) {
+        return;
+    }
+    deck_tempo[deck] = tempo == 1.0 ? 1.0 : TimeStretcher::clamp_ratio(tempo);
+    MixCommand command;
+    command.type = MixCommand::SET_TEMPO;
+    command.deck = deck;
+    command.tempo = deck_tempo[deck];
+    post(command);
+}
+
 /**
  * @brief Display current deck status
  */
 void MixingEngineService::displayDeckStatus() const {
-    std::cout << "\n=== Deck Status ===\n";
+    DJ_LOG(Info, Mixer) << "\n=== Deck Status ===\n";
     for (size_t i = 0; i < 2; ++i) {
         if (decks[i])
-            std::cout << "Deck " << i << ": " << decks[i]->get_title() << "\n";
+            DJ_LOG(Info, Mixer) << "Deck " << i << ": " << decks[i]->get_title() << "\n";
         else
-            std::cout << "Deck " << i << ": [EMPTY]\n";
+            DJ_LOG(Info, Mixer) << "Deck " << i << ": [EMPTY]\n";
     }
-    std::cout << "Active Deck: " << active_deck << "\n";
-    std::cout << "===================\n";
+    DJ_LOG(Info, Mixer) << "Active Deck: " << active_deck << "\n";
+    DJ_LOG(Info, Mixer) << "===================\n";
 }
 
 /**
@@ -115,7 +504,7 @@ void MixingEngineService::displayDeckStatus() const {
  */
 bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track) const {
     if(decks[active_deck] == nullptr || !track) {
-        std::cerr << "[Sync BPM] Cannot sync - one of the decks is empty." << std::endl;
+        DJ_LOG_ERR(Warn, Mixer) << "[Sync BPM] Cannot sync - one of the decks is empty." << std::endl;
         return false; // Cannot mix if active deck is empty or track is null
     }
     int bpm_active = decks[active_deck]->get_bpm();
@@ -140,6 +529,6 @@ void MixingEngineService::sync_bpm(const PointerWrapper<AudioTrack>& track) cons
         int average_bpm = (active_bpm + original_bpm) / 2;
         
         track->set_bpm(average_bpm);
-        std::cout << "[Sync BPM] Syncing BPM from " << original_bpm << " to " << average_bpm << std::endl;
+        DJ_LOG(Info, Mixer) << "[Sync BPM] Syncing BPM from " << original_bpm << " to " << average_bpm << std::endl;
     }
 }
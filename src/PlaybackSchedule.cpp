@@ -0,0 +1,29 @@
+#include "PlaybackSchedule.h"
+#include "EvictionPolicy.h"
+#include <algorithm>
+
+const size_t PlaybackSchedule::NEVER;
+
+PlaybackSchedule::PlaybackSchedule() : order(), positions(), cursor(0) {}
+
+void PlaybackSchedule::reset(const std::vector<std::string>& titles) {
+    order = titles;
+    positions.clear();
+    cursor = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        positions[policy_key_hash(order[i])].push_back(i);
+    }
+}
+
+size_t PlaybackSchedule::nextUse(const std::string& title) const {
+    return nextUseOfHash(policy_key_hash(title));
+}
+
+size_t PlaybackSchedule::nextUseOfHash(uint64_t key_hash) const {
+    auto it = positions.find(key_hash);
+    if (it == positions.end()) return NEVER;
+
+    const std::vector<size_t>& uses = it->second;
+    auto next = std::lower_bound(uses.begin(), uses.end(), cursor);
+    return next == uses.end() ? NEVER : *next;
+}
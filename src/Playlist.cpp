@@ -1,48 +1,36 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
-#include <iostream>
+#include "Logger.h"
 #include <algorithm>
 Playlist::Playlist(const std::string& name) 
-    : head(nullptr), playlist_name(name), track_count(0) {
-    std::cout << "Created playlist: " << name << std::endl;
+    : tracks(), title_index(), playlist_name(name), track_count(0), total_duration(0) {
+    DJ_LOG(Info, Playlist) << "Created playlist: " << name << std::endl;
 }
-// TODO: Fix memory leaks!
-// Students must fix this in Phase 1
+
 Playlist::~Playlist() {
     #ifdef DEBUG
-    std::cout << "Destroying playlist: " << playlist_name << std::endl;
+    DJ_LOG(Debug, Playlist) << "Destroying playlist: " << playlist_name << std::endl;
     #endif
 
-    // FIX: Iterate and delete every PlaylistNode
-    PlaylistNode* current = head;
-    PlaylistNode* next_node = nullptr;
-
-    while (current) {
-        next_node = current->next;
-        
-        // Delete the AudioTrack object BEFORE deleting the node.
-        // This assumes the Playlist has ownership of the tracks as they are copied into it.
-        delete current->track;
-        delete current; 
+    release_tracks();
+}
 
-        current = next_node;
-    }
-    head = nullptr;
+void Playlist::release_tracks() {
+    // Handles release the tracks once no playlist, library or cache refers to them
+    tracks.clear();
+    title_index.clear();
     track_count = 0;
-
+    total_duration = 0;
 }
 
 Playlist::Playlist(const Playlist& other)
-    : head(nullptr), playlist_name(other.playlist_name), track_count(0) {
-
-    // Deep copy each track from the other playlist
-    PlaylistNode* current = other.head;
-    while (current) {
-        // Clone the AudioTrack to ensure deep copy
-        AudioTrack* cloned_track = current->track->clone().release();
-        add_track(cloned_track);
-        current = current->next;
-    }
+    : tracks(), title_index(), playlist_name(other.playlist_name), track_count(0), total_duration(0) {
+
+    // Share the other playlist's tracks; nothing is cloned
+    tracks = other.tracks;
+    title_index = other.title_index;
+    track_count = other.track_count;
+    total_duration = other.total_duration;
 }
 
 Playlist& Playlist::operator=(const Playlist& other) {
@@ -53,88 +41,86 @@ Playlist& Playlist::operator=(const Playlist& other) {
     }
 
     // Clean up existing resources WITHOUT calling the destructor directly
-    PlaylistNode* current = head;
-    while (current) {
-        PlaylistNode* next_node = current->next;
-        delete current->track;
-        delete current;
-        current = next_node;
-    }
+    release_tracks();
 
     // Copy playlist name
     playlist_name = other.playlist_name;
-    head = nullptr;
-    track_count = 0;
 
-    // Deep copy each track from the other playlist
-    PlaylistNode* src = other.head;
-    while (src) {
-        // Clone the AudioTrack to ensure deep copy
-        AudioTrack* cloned_track = src->track->clone().release();
-        add_track(cloned_track);
-        src = src->next;
-    }
+    // Share the other playlist's tracks; nothing is cloned
+    tracks = other.tracks;
+    title_index = other.title_index;
+    track_count = other.track_count;
+    total_duration = other.total_duration;
 
     return *this;
 }
 
 void Playlist::add_track(AudioTrack* track) {
+    // The playlist takes ownership of a raw track through a fresh handle
+    add_track(TrackHandle(track));
+}
+
+void Playlist::add_track(const TrackHandle& track) {
     if (!track) {
-        std::cout << "[Error] Cannot add null track to playlist" << std::endl;
+        DJ_LOG(Error, Playlist) << "[Error] Cannot add null track to playlist" << std::endl;
         return;
     }
 
-    // Create new node - this allocates memory!
-    PlaylistNode* new_node = new PlaylistNode(track);
-
-    // Add to front of list 
-    new_node->next = head;
-    head = new_node;
+    // Append in play order; like the old front-inserted list, lookups by
+    // title see the most recently added track with that title
+    title_index[track->get_title()] = tracks.size();
+    tracks.push_back(track);
     track_count++;
+    total_duration += track->get_duration();
 
-    std::cout << "Added '" << track->get_title() << "' to playlist '" 
+    DJ_LOG(Info, Playlist) << "Added '" << track->get_title() << "' to playlist '" 
               << playlist_name << "'" << std::endl;
 }
 
 void Playlist::remove_track(const std::string& title) {
-    PlaylistNode* current = head;
-    PlaylistNode* prev = nullptr;
+    auto found = title_index.find(title);
 
-    // Find the track to remove
-    while (current && current->track->get_title() != title) {
-        prev = current;
-        current = current->next;
-    }
+    if (found != title_index.end()) {
+        size_t position = found->second;
+        total_duration -= tracks[position]->get_duration();
+        // Dropping the handle frees the track only if nothing else shares it
+        tracks.erase(tracks.begin() + position);
+        track_count--;
 
-    if (current) {
-        // Remove from linked list
-        if (prev) {
-            prev->next = current->next;
+        // Tracks after the removed one moved down by one; re-point the index
+        // entries that referred to them. The removed track was the latest with
+        // its title, so the title passes to the latest earlier occurrence.
+        for (size_t i = position; i < tracks.size(); ++i) {
+            auto entry = title_index.find(tracks[i]->get_title());
+            if (entry->second == i + 1) {
+                entry->second = i;
+            }
+        }
+        size_t earlier = position;
+        while (earlier > 0 && tracks[earlier - 1]->get_title() != title) {
+            --earlier;
+        }
+        if (earlier > 0) {
+            found->second = earlier - 1;
         } else {
-            head = current->next;
+            title_index.erase(found);
         }
-        //delete the audio track as the playlist holds a copy of the original track
-        delete current->track;
-        //Delete the playlist node itself (and not only the pointers to it)
-        delete current;
 
-        track_count--;
-        std::cout << "Removed '" << title << "' from playlist" << std::endl;
+        DJ_LOG(Info, Playlist) << "Removed '" << title << "' from playlist" << std::endl;
 
     } else {
-        std::cout << "Track '" << title << "' not found in playlist" << std::endl;
+        DJ_LOG(Info, Playlist) << "Track '" << title << "' not found in playlist" << std::endl;
     }
 }
 
 void Playlist::display() const {
-    std::cout << "\n=== Playlist: " << playlist_name << " ===" << std::endl;
-    std::cout << "Track count: " << track_count << std::endl;
+    DJ_LOG(Info, Playlist) << "\n=== Playlist: " << playlist_name << " ===" << std::endl;
+    DJ_LOG(Info, Playlist) << "Track count: " << track_count << std::endl;
 
-    PlaylistNode* current = head;
     int index = 1;
 
-    while (current) {
-        std::vector<std::string> artists = current->track->get_artists();
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const std::vector<std::string>& artists = tracks[i]->get_artists();
         std::string artist_list;
 
         std::for_each(artists.begin(), artists.end(), [&](const std::string& artist) {
@@ -144,53 +130,41 @@ void Playlist::display() const {
             artist_list += artist;
         });
 
-        AudioTrack* track = current->track;
-        std::cout << index << ". " << track->get_title() 
+        const AudioTrack* track = tracks[i].get();
+        DJ_LOG(Info, Playlist) << index << ". " << track->get_title() 
                   << " by " << artist_list
                   << " (" << track->get_duration() << "s, " 
                   << track->get_bpm() << " BPM)" << std::endl;
-        current = current->next;
         index++;
     }
 
     if (track_count == 0) {
-        std::cout << "(Empty playlist)" << std::endl;
+        DJ_LOG(Info, Playlist) << "(Empty playlist)" << std::endl;
     }
-    std::cout << "========================\n" << std::endl;
+    DJ_LOG(Info, Playlist) << "========================\n" << std::endl;
 }
 
 AudioTrack* Playlist::find_track(const std::string& title) const {
-    PlaylistNode* current = head;
-
-    while (current) {
-        if (current->track->get_title() == title) {
-            return current->track;
-        }
-        current = current->next;
+    auto found = title_index.find(title);
+    if (found == title_index.end()) {
+        return nullptr;
     }
-
-    return nullptr;
+    return tracks[found->second].get();
 }
 
-int Playlist::get_total_duration() const {
-    int total = 0;
-    PlaylistNode* current = head;
-
-    while (current) {
-        total += current->track->get_duration();
-        current = current->next;
+TrackHandle Playlist::find_track_handle(const std::string& title) const {
+    auto found = title_index.find(title);
+    if (found == title_index.end()) {
+        return TrackHandle();
     }
-
-    return total;
+    return tracks[found->second];
 }
 
 std::vector<AudioTrack*> Playlist::getTracks() const {
-    std::vector<AudioTrack*> tracks;
-    PlaylistNode* current = head;
-    while (current) {
-        if (current->track)
-            tracks.push_back(current->track);
-        current = current->next;
+    std::vector<AudioTrack*> raw;
+    raw.reserve(tracks.size());
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        raw.push_back(tracks[i].get());
     }
-    return tracks;
-}
\ No newline at end of file
+    return raw;
+}
@@ -0,0 +1,77 @@
+#include "PolicyLists.h"
+
+const size_t SlotList::NONE;
+
+SlotList::SlotList(size_t capacity)
+    : prev(), next(), member(), head(NONE), tail(NONE), count(0) {
+    reset(capacity);
+}
+
+void SlotList::reset(size_t capacity) {
+    prev.assign(capacity, NONE);
+    next.assign(capacity, NONE);
+    member.assign(capacity, false);
+    head = NONE;
+    tail = NONE;
+    count = 0;
+}
+
+void SlotList::pushFront(size_t slot) {
+    if (slot >= member.size()) {
+        // Slot vector grew behind our back; widen the link arrays
+        prev.resize(slot + 1, NONE);
+        next.resize(slot + 1, NONE);
+        member.resize(slot + 1, false);
+    }
+    if (member[slot]) remove(slot);
+
+    prev[slot] = NONE;
+    next[slot] = head;
+    if (head != NONE) prev[head] = slot;
+    head = slot;
+    if (tail == NONE) tail = slot;
+    member[slot] = true;
+    ++count;
+}
+
+void SlotList::remove(size_t slot) {
+    if (!contains(slot)) return;
+
+    if (prev[slot] != NONE) next[prev[slot]] = next[slot];
+    else head = next[slot];
+
+    if (next[slot] != NONE) prev[next[slot]] = prev[slot];
+    else tail = prev[slot];
+
+    prev[slot] = NONE;
+    next[slot] = NONE;
+    member[slot] = false;
+    --count;
+}
+
+GhostList::GhostList() : order(), lookup() {}
+
+void GhostList::pushFront(uint64_t key) {
+    remove(key);
+    order.push_front(key);
+    lookup[key] = order.begin();
+}
+
+bool GhostList::remove(uint64_t key) {
+    auto it = lookup.find(key);
+    if (it == lookup.end()) return false;
+    order.erase(it->second);
+    lookup.erase(it);
+    return true;
+}
+
+void GhostList::popBack() {
+    if (order.empty()) return;
+    lookup.erase(order.back());
+    order.pop_back();
+}
+
+void GhostList::clear() {
+    order.clear();
+    lookup.clear();
+}
@@ -1,15 +1,109 @@
 #include "SessionFileParser.h"
-#include <iostream>
+#include "LibrarySnapshot.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
 #include <sstream>
 #include <algorithm>
+#include <climits>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Visit each line of text with its 1-based number, trimmed, skipping empty
+ * lines and comments. Lines end at '\n'; a final line without one counts.
+ * Returns the number of lines, including skipped ones.
+ */
+template<typename Visitor>
+int for_each_line(StringRef text, Visitor visit) {
+    int line_number = 0;
+    size_t pos = 0;
+    while (pos < text.size) {
+        size_t line_end = text.find('\n', pos);
+        if (line_end == StringRef::npos) {
+            line_end = text.size;
+        }
+        StringRef line = text.substr(pos, line_end - pos).trim();
+        pos = line_end + 1;
+        line_number++;
+        
+        if (!line.empty() && line.front() != '#') {
+            visit(line, line_number);
+        }
+    }
+    return line_number;
+}
+
+/**
+ * Visit each field of text split on delimiter, trimmed, with std::getline
+ * semantics: an empty text has no fields and a trailing delimiter does not
+ * start an empty last field. Stops early when visit returns false.
+ */
+template<typename Visitor>
+void for_each_field(StringRef text, char delimiter, Visitor visit) {
+    size_t pos = 0;
+    while (pos < text.size) {
+        size_t field_end = text.find(delimiter, pos);
+        if (field_end == StringRef::npos) {
+            field_end = text.size;
+        }
+        if (!visit(text.substr(pos, field_end - pos).trim())) {
+            return;
+        }
+        pos = field_end + 1;
+    }
+}
+
+// isspace() in the C locale, as skipped by std::stoi
+bool is_c_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+}  // namespace
+
+size_t SessionConfig::library_size() const {
+    return snapshot_tracks ? snapshot_tracks->size() : library_tracks.size();
+}
 
 // ========== PUBLIC METHODS (PROVIDED FOR STUDENTS) ==========
 
+ParserMode SessionFileParser::mode = ParserMode::Parallel;
+size_t SessionFileParser::parser_threads = 0;
+
 bool SessionFileParser::parse_config_file(const std::string& config_path, SessionConfig& config) {
+    if (mode != ParserMode::Stream) {
+        MappedFile file;
+        if (file.open(config_path)) {
+            if (mode == ParserMode::Parallel) {
+                size_t threads = parser_threads ? parser_threads : ThreadPool::default_threads();
+                return parse_config_parallel(file.view(), threads, config);
+            }
+            return parse_config_mapped(file.view(), config);
+        }
+        // Unmappable or missing: the stream parser reads it or reports the error
+    }
+    return parse_config_stream(config_path, config);
+}
+
+void SessionFileParser::set_parser_mode(ParserMode parser_mode) {
+    mode = parser_mode;
+}
+
+ParserMode SessionFileParser::parser_mode() {
+    return mode;
+}
+
+void SessionFileParser::set_parser_threads(size_t threads) {
+    parser_threads = threads;
+}
+
+bool SessionFileParser::parse_config_stream(const std::string& config_path, SessionConfig& config) {
     std::ifstream file(config_path);
     
     if (!file.is_open()) {
-        std::cout << "[ERROR] Cannot open config file: " << config_path << std::endl;
+        DJ_LOG(Error, Parser) << "[ERROR] Cannot open config file: " << config_path << std::endl;
         return false;
     }
     
@@ -29,37 +123,17 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
         std::string key, value;
         if (parse_key_value(line, key, value)) {
             
-            if (key == "app_name") {
-                config.app_name = value;
-                
-            } else if (key == "version") {
-                config.version = value;
-                
-            } else if (key.find("library_track_") == 0) {
+            if (key.find("library_track_") == 0) {
                 // Handle library_track_1, library_track_2, etc.
                 SessionConfig::TrackInfo track_info;
                 if (parse_library_track(value, track_info)) {
                     config.library_tracks.push_back(track_info);
                 } else {
-                    std::cout << "[WARNING] Invalid track format at line " << line_number << std::endl;
-                }
-                
-            } else if (key == "controller_cache_size") {
-                try {
-                    config.controller_cache_size = std::stoi(value);
-                } catch (const std::exception& e) {
-                    std::cout << "[WARNING] Invalid cache size at line " << line_number << std::endl;
-                }
-                
-            } else if (key == "bpm_tolerance") {
-                try {
-                    config.bpm_tolerance = std::stoi(value);
-                } catch (const std::exception& e) {
-                    std::cout << "[WARNING] Invalid BPM tolerance at line " << line_number << std::endl;
+                    DJ_LOG(Warn, Parser) << "[WARNING] Invalid track format at line " << line_number << std::endl;
                 }
                 
-            } else if (key == "auto_sync") {
-                config.auto_sync = parse_bool(value);
+            } else if (apply_setting(key, value, line_number, config)) {
+                // Named setting applied (or warned about)
                 
             } else {
                 // Check if it's a playlist definition (any other key=value where value contains numbers/commas)
@@ -68,22 +142,221 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
                 if (parse_playlist_line(line, playlist_name, track_indices)) {
                     config.playlists[playlist_name] = track_indices;
                 } else {
-                    std::cout << "[WARNING] Unknown config key '" << key << "' at line " << line_number << std::endl;
+                    DJ_LOG(Warn, Parser) << "[WARNING] Unknown config key '" << key << "' at line " << line_number << std::endl;
                 }
             }
             
         } else {
-            std::cout << "[WARNING] Cannot parse line " << line_number << ": " << line << std::endl;
+            DJ_LOG(Warn, Parser) << "[WARNING] Cannot parse line " << line_number << ": " << line << std::endl;
         }
     }
     
     file.close();
     
-    std::cout << "Parsed config file: " << config.library_tracks.size() << " tracks found, " 
+    DJ_LOG(Info, Parser) << "Parsed config file: " << config.library_tracks.size() << " tracks found, " 
               << config.playlists.size() << " playlists found" << std::endl;
     return true;
 }
 
+bool SessionFileParser::parse_config_mapped(StringRef text, SessionConfig& config) {
+    // Mirrors parse_config_stream line for line; only the tokenizing differs
+    for_each_line(text, [&config](StringRef line, int line_number) {
+        apply_line(line, line_number, config);
+    });
+    
+    DJ_LOG(Info, Parser) << "Parsed config file: " << config.library_tracks.size() << " tracks found, " 
+              << config.playlists.size() << " playlists found" << std::endl;
+    return true;
+}
+
+/**
+ * Lines a worker could not finish are replayed in order by the merge:
+ * invalid library tracks only need their warning, anything else is
+ * applied with apply_line. Views point into the mapped file.
+ */
+struct SessionFileParser::ParsedChunk {
+    struct Deferred {
+        StringRef line;
+        int line_number;        // within the chunk, 1-based
+        bool invalid_track;
+    };
+    
+    StringRef text;
+    std::vector<SessionConfig::TrackInfo> tracks;
+    std::vector<Deferred> deferred;
+    int line_count;
+    
+    ParsedChunk() : text(), tracks(), deferred(), line_count(0) {}
+};
+
+bool SessionFileParser::parse_config_parallel(StringRef text, size_t threads, SessionConfig& config) {
+    // Small inputs are not worth the hand-off
+    const size_t min_chunk_bytes = 64 * 1024;
+    if (threads <= 1 || text.size < 2 * min_chunk_bytes) {
+        return parse_config_mapped(text, config);
+    }
+    
+    // A few chunks per thread evens out uneven lines; boundaries follow a '\n'
+    size_t chunk_count = std::min(threads * 4, text.size / min_chunk_bytes);
+    std::vector<ParsedChunk> chunks(chunk_count);
+    size_t begin = 0;
+    for (size_t i = 0; i < chunk_count; ++i) {
+        size_t end = text.size;
+        if (i + 1 < chunk_count) {
+            size_t newline = text.find('\n', std::max(begin, text.size * (i + 1) / chunk_count));
+            end = (newline == StringRef::npos) ? text.size : newline + 1;
+        }
+        chunks[i].text = text.substr(begin, end - begin);
+        begin = end;
+    }
+    
+    {
+        ThreadPool pool(std::min(threads, chunk_count));
+        std::vector<std::future<void>> pending;
+        pending.reserve(chunk_count);
+        for (ParsedChunk& chunk : chunks) {
+            ParsedChunk* target = &chunk;
+            pending.push_back(pool.submit([target]() { parse_chunk(target->text, *target); }));
+        }
+        for (std::future<void>& done : pending) {
+            done.get();
+        }
+    }
+    
+    // Merge in file order: track indices and warning order match a serial parse
+    size_t total_tracks = config.library_tracks.size();
+    for (const ParsedChunk& chunk : chunks) {
+        total_tracks += chunk.tracks.size();
+    }
+    config.library_tracks.reserve(total_tracks);
+    
+    int line_base = 0;
+    for (ParsedChunk& chunk : chunks) {
+        std::move(chunk.tracks.begin(), chunk.tracks.end(), std::back_inserter(config.library_tracks));
+        for (const ParsedChunk::Deferred& entry : chunk.deferred) {
+            int line_number = line_base + entry.line_number;
+            if (entry.invalid_track) {
+                DJ_LOG(Warn, Parser) << "[WARNING] Invalid track format at line " << line_number << std::endl;
+            } else {
+                apply_line(entry.line, line_number, config);
+            }
+        }
+        line_base += chunk.line_count;
+    }
+    
+    DJ_LOG(Info, Parser) << "Parsed config file: " << config.library_tracks.size() << " tracks found, " 
+              << config.playlists.size() << " playlists found" << std::endl;
+    return true;
+}
+
+void SessionFileParser::parse_chunk(StringRef text, ParsedChunk& chunk) {
+    // Runs on a worker: touches only the chunk, never the config or the log
+    chunk.line_count = for_each_line(text, [&chunk](StringRef line, int line_number) {
+        size_t equals_pos = line.find('=');
+        if (equals_pos != StringRef::npos) {
+            StringRef key = line.substr(0, equals_pos).trim();
+            if (key.starts_with("library_track_")) {
+                SessionConfig::TrackInfo track_info;
+                if (parse_library_track(line.substr(equals_pos + 1).trim(), track_info)) {
+                    chunk.tracks.push_back(std::move(track_info));
+                } else {
+                    chunk.deferred.push_back(ParsedChunk::Deferred{line, line_number, true});
+                }
+                return;
+            }
+        }
+        chunk.deferred.push_back(ParsedChunk::Deferred{line, line_number, false});
+    });
+}
+
+void SessionFileParser::apply_line(StringRef line, int line_number, SessionConfig& config) {
+    size_t equals_pos = line.find('=');
+    StringRef key = line.substr(0, equals_pos).trim();
+    if (equals_pos == StringRef::npos || key.empty()) {
+        DJ_LOG(Warn, Parser) << "[WARNING] Cannot parse line " << line_number << ": " << line.str() << std::endl;
+        return;
+    }
+    StringRef value = line.substr(equals_pos + 1).trim();
+    
+    if (key.starts_with("library_track_")) {
+        SessionConfig::TrackInfo track_info;
+        if (parse_library_track(value, track_info)) {
+            config.library_tracks.push_back(std::move(track_info));
+        } else {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid track format at line " << line_number << std::endl;
+        }
+        
+    } else if (apply_setting(key, value, line_number, config)) {
+        // Named setting applied (or warned about)
+        
+    } else {
+        std::vector<int> track_indices;
+        if (parse_playlist_indices(key, value, track_indices)) {
+            config.playlists[key.str()] = std::move(track_indices);
+        } else {
+            DJ_LOG(Warn, Parser) << "[WARNING] Unknown config key '" << key.str() << "' at line " << line_number << std::endl;
+        }
+    }
+}
+
+bool SessionFileParser::apply_setting(StringRef key, StringRef value, int line_number, SessionConfig& config) {
+    // Settings appear once per file, so values go through the std::string parsers
+    if (key == "app_name") {
+        config.app_name = value.str();
+        
+    } else if (key == "version") {
+        config.version = value.str();
+        
+    } else if (key == "controller_cache_size") {
+        try {
+            config.controller_cache_size = std::stoi(value.str());
+        } catch (const std::exception& e) {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid cache size at line " << line_number << std::endl;
+        }
+        
+    } else if (key == "controller_cache_bytes") {
+        try {
+            if (!value.empty() && value[0] == '-') {
+                throw std::invalid_argument(value.str());
+            }
+            config.controller_cache_bytes = static_cast<size_t>(std::stoull(value.str()));
+        } catch (const std::exception& e) {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid cache byte budget at line " << line_number << std::endl;
+        }
+        
+    } else if (key == "cache_policy") {
+        config.cache_policy = value.str();
+        
+    } else if (key == "controller_lookahead") {
+        try {
+            config.controller_lookahead = std::stoi(value.str());
+        } catch (const std::exception& e) {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid controller lookahead at line " << line_number << std::endl;
+        }
+        
+    } else if (key == "controller_cache_shards") {
+        try {
+            config.controller_cache_shards = std::stoi(value.str());
+        } catch (const std::exception& e) {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid cache shard count at line " << line_number << std::endl;
+        }
+        
+    } else if (key == "bpm_tolerance") {
+        try {
+            config.bpm_tolerance = std::stoi(value.str());
+        } catch (const std::exception& e) {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid BPM tolerance at line " << line_number << std::endl;
+        }
+        
+    } else if (key == "auto_sync") {
+        config.auto_sync = parse_bool(value.str());
+        
+    } else {
+        return false;
+    }
+    return true;
+}
+
 
 std::string SessionFileParser::extract_playlist_name(const std::string& playlist_path) {
     // TODO: Students implement name extraction
@@ -250,9 +523,106 @@ bool SessionFileParser::parse_playlist_line(const std::string& line, std::string
             track_indices.push_back(idx);
         } catch (const std::exception& e) {
             // Skip invalid indices
-            std::cout << "[WARNING] Invalid track index in playlist '" << playlist_name << "': " << idx_str << std::endl;
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid track index in playlist '" << playlist_name << "': " << idx_str << std::endl;
         }
     }
     
     return !track_indices.empty();
-}
\ No newline at end of file
+}
+
+// ========== ALLOCATION-FREE TOKENIZING (MAPPED MODE) ==========
+
+bool SessionFileParser::parse_int(StringRef text, int& value) {
+    size_t pos = 0;
+    while (pos < text.size && is_c_space(text[pos])) {
+        ++pos;
+    }
+    
+    bool negative = false;
+    if (pos < text.size && (text[pos] == '+' || text[pos] == '-')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+    if (pos >= text.size || text[pos] < '0' || text[pos] > '9') {
+        return false;
+    }
+    
+    // Accumulate the magnitude; INT_MIN's magnitude is one past INT_MAX
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    long long magnitude = 0;
+    for (; pos < text.size && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+        magnitude = magnitude * 10 + (text[pos] - '0');
+        if (magnitude > limit) {
+            return false;
+        }
+    }
+    
+    value = static_cast<int>(negative ? -magnitude : magnitude);
+    return true;
+}
+
+bool SessionFileParser::parse_library_track(StringRef line, SessionConfig::TrackInfo& track_info) {
+    // Same format and checks as the std::string overload
+    StringRef parts[7];
+    size_t count = 0;
+    for_each_field(line, ',', [&parts, &count](StringRef field) {
+        parts[count++] = field;
+        return count < 7;
+    });
+    
+    if (count < 7) {
+        return false;
+    }
+    if (parts[0] != "MP3" && parts[0] != "WAV") {
+        return false;
+    }
+    if (!parse_int(parts[3], track_info.duration_seconds) ||
+        !parse_int(parts[4], track_info.bpm) ||
+        !parse_int(parts[5], track_info.extra_param1) ||   // bitrate or sample_rate
+        !parse_int(parts[6], track_info.extra_param2)) {   // has_tags or bit_depth
+        return false;
+    }
+    
+    track_info.type = parts[0].str();
+    track_info.title = parts[1].str();
+    parse_artist_list(parts[2], track_info.artists);
+    return true;
+}
+
+void SessionFileParser::parse_artist_list(StringRef artist_str, std::vector<std::string>& artists) {
+    artists.clear();
+    StringRef cleaned = artist_str.trim();
+    
+    // Remove curly braces
+    if (cleaned.size >= 2 && cleaned.front() == '{' && cleaned.back() == '}') {
+        cleaned = cleaned.substr(1, cleaned.size - 2);
+    }
+    
+    for_each_field(cleaned, ';', [&artists](StringRef artist) {
+        if (!artist.empty()) {
+            artists.push_back(artist.str());
+        }
+        return true;
+    });
+    
+    if (artists.empty()) {
+        artists.push_back("Unknown Artist");
+    }
+}
+
+bool SessionFileParser::parse_playlist_indices(StringRef playlist_name, StringRef value, std::vector<int>& track_indices) {
+    track_indices.clear();
+    
+    for_each_field(value, ',', [&playlist_name, &track_indices](StringRef idx_str) {
+        int idx = 0;
+        if (parse_int(idx_str, idx)) {
+            track_indices.push_back(idx);
+        } else {
+            DJ_LOG(Warn, Parser) << "[WARNING] Invalid track index in playlist '" << playlist_name.str() << "': "
+                                 << idx_str.str() << std::endl;
+        }
+        return true;
+    });
+    
+    return !track_indices.empty();
+}
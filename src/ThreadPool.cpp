@@ -0,0 +1,158 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace {
+
+/**
+ * One worker's share of a parallel_for: the owner takes from the front,
+ * thieves from the back
+ */
+struct StealRange {
+    std::mutex lock;
+    size_t begin;
+    size_t end;
+
+    StealRange() : lock(), begin(0), end(0) {}
+};
+
+bool take_front(StealRange& range, size_t grain, size_t& begin, size_t& end) {
+    std::lock_guard<std::mutex> guard(range.lock);
+    if (range.begin == range.end) {
+        return false;
+    }
+    begin = range.begin;
+    end = range.end - begin > grain ? begin + grain : range.end;
+    range.begin = end;
+    return true;
+}
+
+/**
+ * Move the back half of victim (all of it when one index is left) into the
+ * thief's share, which is empty
+ */
+bool steal_half(StealRange& victim, StealRange& thief) {
+    size_t begin;
+    size_t end;
+    {
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.begin == victim.end) {
+            return false;
+        }
+        begin = victim.begin + (victim.end - victim.begin) / 2;
+        end = victim.end;
+        victim.end = begin;
+    }
+    std::lock_guard<std::mutex> guard(thief.lock);
+    thief.begin = begin;
+    thief.end = end;
+    return true;
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads) : workers(), tasks(), lock(), wake(), stopping(false) {
+    if (threads == 0) {
+        threads = default_threads();
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(std::move(packaged));
+    }
+    wake.notify_one();
+    return result;
+}
+
+void ThreadPool::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t shares = std::min(workers.size(), count / grain + (count % grain != 0));
+    std::vector<StealRange> ranges(shares);
+    size_t next = 0;
+    for (size_t i = 0; i < shares; ++i) {
+        ranges[i].begin = next;
+        next += count / shares + (i < count % shares);
+        ranges[i].end = next;
+    }
+
+    std::vector<std::future<void>> done;
+    done.reserve(shares);
+    for (size_t self = 0; self < shares; ++self) {
+        done.push_back(submit([&ranges, &body, grain, self]() {
+            size_t begin = 0;
+            size_t end = 0;
+            for (;;) {
+                if (take_front(ranges[self], grain, begin, end)) {
+                    body(begin, end);
+                    continue;
+                }
+                bool stolen = false;
+                for (size_t k = 1; k < ranges.size() && !stolen; ++k) {
+                    stolen = steal_half(ranges[(self + k) % ranges.size()], ranges[self]);
+                }
+                if (!stolen) {
+                    return;
+                }
+            }
+        }));
+    }
+
+    // Every task refers to ranges and body, so wait for all before rethrowing
+    std::exception_ptr failure;
+    for (std::future<void>& task : done) {
+        try {
+            task.get();
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+size_t ThreadPool::default_threads() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;  // stopping, and the queue is drained
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,150 @@
+#include "TimeStretcher.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const size_t TimeStretcher::FRAME;
+const size_t TimeStretcher::HOP;
+const size_t TimeStretcher::TOLERANCE;
+const size_t TimeStretcher::LOOKAHEAD;
+constexpr double TimeStretcher::MIN_RATIO;
+constexpr double TimeStretcher::MAX_RATIO;
+
+namespace {
+
+const long long COARSE_STEP = 4;   // candidate spacing of the first search pass
+
+// count must be a multiple of 4; four partial sums keep the adds independent
+double correlate(const double* a, const double* b, size_t count) {
+    double sum[4] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < count; i += 4) {
+        sum[0] += a[i] * b[i];
+        sum[1] += a[i + 1] * b[i + 1];
+        sum[2] += a[i + 2] * b[i + 2];
+        sum[3] += a[i + 3] * b[i + 3];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+}  // namespace
+
+TimeStretcher::TimeStretcher()
+    : source(nullptr), length(0), speed(1.0), nominal(0.0), previous(0), has_previous(false),
+      window(FRAME), overlap(FRAME, 0.0), emitted(0), ready(0),
+      region(2 * TOLERANCE + FRAME, 0.0), target(HOP, 0.0) {
+    // Periodic Hann: windows spaced HOP = FRAME / 2 apart sum to exactly 1
+    const double pi = std::acos(-1.0);
+    for (size_t n = 0; n < FRAME; ++n) {
+        window[n] = 0.5 - 0.5 * std::cos(2.0 * pi * n / FRAME);
+    }
+}
+
+void TimeStretcher::reset(const double* samples, size_t count, double position) {
+    source = samples;
+    length = samples ? count : 0;
+    std::fill(overlap.begin(), overlap.end(), 0.0);
+    has_previous = false;
+    emitted = 0;
+    ready = 0;
+
+    // Prime with the frame before position and drop its output, so the
+    // first real HOP overlaps a predecessor instead of fading in
+    nominal = std::max(0.0, position) - HOP * speed;
+    if (source && synthesize()) {
+        ready = 0;
+    }
+}
+
+void TimeStretcher::set_ratio(double ratio) {
+    speed = clamp_ratio(ratio);
+}
+
+double TimeStretcher::clamp_ratio(double ratio) {
+    return ratio > MIN_RATIO ? std::min(ratio, MAX_RATIO) : MIN_RATIO;   // NaN -> MIN_RATIO
+}
+
+double TimeStretcher::position() const {
+    double position = nominal - ready * speed;
+    return std::min(std::max(position, 0.0), static_cast<double>(length));
+}
+
+void TimeStretcher::fetch(long long start, size_t count, double* out) const {
+    const long long end = start + static_cast<long long>(count);
+    const long long first = std::max(start, 0LL);
+    const long long last = std::min(end, static_cast<long long>(length));
+    if (first >= last) {
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+    std::fill(out, out + (first - start), 0.0);
+    std::memcpy(out + (first - start), source + first, (last - first) * sizeof(double));
+    std::fill(out + (last - start), out + count, 0.0);
+}
+
+long long TimeStretcher::best_position(long long center) {
+    // region[i] holds the input at center - TOLERANCE + i
+    const long long low = center - static_cast<long long>(TOLERANCE);
+    fetch(low, region.size(), region.data());
+    fetch(previous + static_cast<long long>(HOP), HOP, target.data());
+
+    const long long span = 2 * static_cast<long long>(TOLERANCE);
+    long long best = TOLERANCE;
+    double best_score = correlate(region.data() + best, target.data(), HOP);
+    for (long long offset = 0; offset <= span; offset += COARSE_STEP) {
+        double score = correlate(region.data() + offset, target.data(), HOP);
+        if (score > best_score) {
+            best_score = score;
+            best = offset;
+        }
+    }
+    const long long coarse = best;
+    for (long long offset = std::max(0LL, coarse - COARSE_STEP + 1);
+         offset <= std::min(span, coarse + COARSE_STEP - 1); ++offset) {
+        double score = correlate(region.data() + offset, target.data(), HOP);
+        if (score > best_score) {
+            best_score = score;
+            best = offset;
+        }
+    }
+    return low + best;
+}
+
+bool TimeStretcher::synthesize() {
+    if (!source || nominal >= static_cast<double>(length)) {
+        return false;
+    }
+    // The HOP just written out is final; the tail of the last frame moves up
+    std::copy(overlap.begin() + HOP, overlap.end(), overlap.begin());
+    std::fill(overlap.begin() + HOP, overlap.end(), 0.0);
+
+    const long long center = std::llround(nominal);
+    const long long start = has_previous ? best_position(center) : center;
+
+    // region doubles as the frame buffer once the search is done
+    fetch(start, FRAME, region.data());
+    for (size_t n = 0; n < FRAME; ++n) {
+        overlap[n] += window[n] * region[n];
+    }
+
+    previous = start;
+    has_previous = true;
+    nominal += HOP * speed;
+    emitted = 0;
+    ready = HOP;
+    return true;
+}
+
+size_t TimeStretcher::process(double* out, size_t frames) {
+    size_t produced = 0;
+    while (produced < frames) {
+        if (ready == 0 && !synthesize()) {
+            break;
+        }
+        size_t count = std::min(ready, frames - produced);
+        std::memcpy(out + produced, overlap.data() + emitted, count * sizeof(double));
+        emitted += count;
+        ready -= count;
+        produced += count;
+    }
+    return produced;
+}
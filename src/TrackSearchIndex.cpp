@@ -0,0 +1,294 @@
+#include "TrackSearchIndex.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+const uint32_t TrackSearchIndex::FIELD_BITS;
+const uint32_t TrackSearchIndex::MAX_LIBRARY_INDEX;
+
+namespace {
+
+bool is_token_char(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+char fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+uint32_t library_index_of(uint32_t entry) {
+    return entry >> 2;
+}
+
+/**
+ * Advance cursor to the first entry of list with library index >= index
+ * (galloping, since probes arrive in ascending order) and report whether
+ * that entry is index itself with a field in field_mask.
+ */
+bool seek(const std::vector<uint32_t>& list, size_t& cursor, uint32_t index, uint32_t field_mask) {
+    size_t step = 1;
+    size_t low = cursor;
+    while (low + step < list.size() && library_index_of(list[low + step]) < index) {
+        low += step;
+        step *= 2;
+    }
+    size_t high = std::min(list.size(), low + step + 1);
+    cursor = std::lower_bound(list.begin() + low, list.begin() + high, index,
+                              [](uint32_t entry, uint32_t target) { return library_index_of(entry) < target; })
+             - list.begin();
+    return cursor < list.size() && library_index_of(list[cursor]) == index && (list[cursor] & field_mask) != 0;
+}
+
+}  // namespace
+
+TrackSearchIndex::TrackSearchIndex()
+    : token_ids(), tokens(), postings(), tracks(0), last_index(-1), sorted_tokens(), sorted_count(0) {}
+
+void TrackSearchIndex::clear() {
+    token_ids.clear();
+    tokens.clear();
+    postings.clear();
+    tracks = 0;
+    last_index = -1;
+    sorted_tokens.clear();
+    sorted_count = 0;
+}
+
+std::vector<std::string> TrackSearchIndex::tokenize(const std::string& text) {
+    std::vector<std::string> result;
+    std::string current;
+    for (char c : text) {
+        if (is_token_char(c)) {
+            current += fold(c);
+        } else if (!current.empty()) {
+            result.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        result.push_back(current);
+    }
+    return result;
+}
+
+bool TrackSearchIndex::add(uint32_t library_index, const std::string& title,
+                           const std::vector<std::string>& artists) {
+    if (library_index > MAX_LIBRARY_INDEX || static_cast<int64_t>(library_index) <= last_index) {
+        return false;
+    }
+    uint32_t entry = library_index << FIELD_BITS;
+    std::string token;
+    add_tokens(title, entry | static_cast<uint32_t>(SearchField::Title), token);
+    for (const std::string& artist : artists) {
+        add_tokens(artist, entry | static_cast<uint32_t>(SearchField::Artist), token);
+    }
+    last_index = library_index;
+    ++tracks;
+    return true;
+}
+
+void TrackSearchIndex::add_tokens(const std::string& text, uint32_t entry, std::string& token) {
+    // Same splitting as tokenize(), without building the token vector
+    token.clear();
+    for (char c : text) {
+        if (is_token_char(c)) {
+            token += fold(c);
+        } else if (!token.empty()) {
+            add_token(token, entry);
+            token.clear();
+        }
+    }
+    if (!token.empty()) {
+        add_token(token, entry);
+    }
+}
+
+void TrackSearchIndex::add_token(const std::string& token, uint32_t entry) {
+    // find() first: emplace() would allocate a node even for known tokens
+    auto found = token_ids.find(token);
+    if (found == token_ids.end()) {
+        found = token_ids.emplace(token, static_cast<uint32_t>(tokens.size())).first;
+        tokens.push_back(token);
+        postings.push_back(std::vector<uint32_t>());
+        sorted_tokens.push_back(found->second);
+    }
+    std::vector<uint32_t>& list = postings[found->second];
+    // A track repeating a token, or having it in both fields, keeps one entry
+    if (!list.empty() && library_index_of(list.back()) == library_index_of(entry)) {
+        list.back() |= entry;
+    } else {
+        list.push_back(entry);
+    }
+}
+
+void TrackSearchIndex::merge_pending_tokens() const {
+    if (sorted_count == sorted_tokens.size()) {
+        return;
+    }
+    auto by_text = [this](uint32_t a, uint32_t b) { return tokens[a] < tokens[b]; };
+    std::sort(sorted_tokens.begin() + sorted_count, sorted_tokens.end(), by_text);
+    std::inplace_merge(sorted_tokens.begin(), sorted_tokens.begin() + sorted_count, sorted_tokens.end(), by_text);
+    sorted_count = sorted_tokens.size();
+}
+
+void TrackSearchIndex::prefix_range(const std::string& prefix, size_t& begin, size_t& end) const {
+    merge_pending_tokens();
+    auto first = std::lower_bound(sorted_tokens.begin(), sorted_tokens.end(), prefix,
+                                  [this](uint32_t id, const std::string& text) { return tokens[id] < text; });
+    auto last = std::partition_point(first, sorted_tokens.end(), [this, &prefix](uint32_t id) {
+        return tokens[id].compare(0, prefix.size(), prefix) == 0;
+    });
+    begin = first - sorted_tokens.begin();
+    end = last - sorted_tokens.begin();
+}
+
+std::vector<uint32_t> TrackSearchIndex::match(std::vector<const std::vector<uint32_t>*> exact,
+                                              const std::vector<const std::vector<uint32_t>*>& prefix,
+                                              uint32_t field_mask, size_t limit) const {
+    std::vector<uint32_t> result;
+    std::sort(exact.begin(), exact.end(),
+              [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+
+    // Plan: drive from the smallest exact list, probing every prefix list per
+    // candidate, or from the merged prefix lists, probing the exact lists
+    size_t prefix_entries = 0;
+    for (const std::vector<uint32_t>* list : prefix) {
+        prefix_entries += list->size();
+    }
+    bool drive_exact = !exact.empty() && (prefix.empty() || exact[0]->size() * prefix.size() <= prefix_entries);
+
+    std::vector<size_t> exact_cursors(exact.size(), 0);
+    auto in_all_exact = [&](uint32_t index, size_t skip) {
+        for (size_t i = skip; i < exact.size(); ++i) {
+            if (!seek(*exact[i], exact_cursors[i], index, field_mask)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (drive_exact) {
+        std::vector<size_t> prefix_cursors(prefix.size(), 0);
+        for (uint32_t entry : *exact[0]) {
+            if ((entry & field_mask) == 0) {
+                continue;
+            }
+            uint32_t index = library_index_of(entry);
+            if (!in_all_exact(index, 1)) {
+                continue;
+            }
+            bool prefix_match = prefix.empty();
+            for (size_t i = 0; i < prefix.size() && !prefix_match; ++i) {
+                prefix_match = seek(*prefix[i], prefix_cursors[i], index, field_mask);
+            }
+            if (prefix_match) {
+                result.push_back(index);
+                if (result.size() >= limit) {
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    // K-way merge of the prefix lists in library order
+    typedef std::pair<uint32_t, size_t> Head;    // library index, list
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    std::vector<size_t> positions(prefix.size(), 0);
+    auto push_next = [&](size_t list) {
+        const std::vector<uint32_t>& entries = *prefix[list];
+        size_t& pos = positions[list];
+        while (pos < entries.size() && (entries[pos] & field_mask) == 0) {
+            ++pos;
+        }
+        if (pos < entries.size()) {
+            heads.push(Head(library_index_of(entries[pos++]), list));
+        }
+    };
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        push_next(i);
+    }
+
+    int64_t previous = -1;
+    while (!heads.empty() && result.size() < limit) {
+        Head head = heads.top();
+        heads.pop();
+        push_next(head.second);
+        if (static_cast<int64_t>(head.first) == previous) {
+            continue;     // same track under another matching token
+        }
+        previous = head.first;
+        if (in_all_exact(head.first, 0)) {
+            result.push_back(head.first);
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> TrackSearchIndex::search(const std::string& query, SearchField field, size_t limit) const {
+    std::vector<std::string> terms = tokenize(query);
+    if (terms.empty() || limit == 0) {
+        return std::vector<uint32_t>();
+    }
+    bool last_is_prefix = is_token_char(query.back());
+
+    std::vector<const std::vector<uint32_t>*> exact;
+    size_t exact_terms = last_is_prefix ? terms.size() - 1 : terms.size();
+    for (size_t i = 0; i < exact_terms; ++i) {
+        auto found = token_ids.find(terms[i]);
+        if (found == token_ids.end()) {
+            return std::vector<uint32_t>();
+        }
+        exact.push_back(&postings[found->second]);
+    }
+
+    std::vector<const std::vector<uint32_t>*> prefix;
+    if (last_is_prefix) {
+        size_t begin = 0;
+        size_t end = 0;
+        prefix_range(terms.back(), begin, end);
+        if (begin == end) {
+            return std::vector<uint32_t>();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            prefix.push_back(&postings[sorted_tokens[i]]);
+        }
+    }
+    return match(exact, prefix, static_cast<uint32_t>(field), limit);
+}
+
+std::vector<uint32_t> TrackSearchIndex::find_by_artists(const std::vector<std::string>& artists, size_t limit) const {
+    std::vector<const std::vector<uint32_t>*> exact;
+    for (const std::string& artist : artists) {
+        for (const std::string& token : tokenize(artist)) {
+            auto found = token_ids.find(token);
+            if (found == token_ids.end()) {
+                return std::vector<uint32_t>();
+            }
+            exact.push_back(&postings[found->second]);
+        }
+    }
+    if (exact.empty() || limit == 0) {
+        return std::vector<uint32_t>();
+    }
+    return match(exact, std::vector<const std::vector<uint32_t>*>(),
+                 static_cast<uint32_t>(SearchField::Artist), limit);
+}
+
+std::vector<std::string> TrackSearchIndex::complete(const std::string& prefix, size_t limit) const {
+    std::string folded;
+    for (char c : prefix) {
+        folded += fold(c);
+    }
+    size_t begin = 0;
+    size_t end = 0;
+    prefix_range(folded, begin, end);
+
+    std::vector<std::string> result;
+    for (size_t i = begin; i < end && result.size() < limit; ++i) {
+        result.push_back(tokens[sorted_tokens[i]]);
+    }
+    return result;
+}
@@ -0,0 +1,55 @@
+#include "TwoQueuePolicy.h"
+#include <algorithm>
+
+TwoQueuePolicy::TwoQueuePolicy(size_t capacity)
+    : capacity(0), kin(1), kout(1), a1in(), am(), a1out(), keys() {
+    reset(capacity);
+}
+
+void TwoQueuePolicy::reset(size_t new_capacity) {
+    capacity = new_capacity;
+    kin = std::max<size_t>(capacity / 4, 1);
+    kout = std::max<size_t>(capacity / 2, 1);
+    a1in.reset(capacity);
+    am.reset(capacity);
+    a1out.clear();
+    keys.assign(capacity, 0);
+}
+
+size_t TwoQueuePolicy::selectVictim(const std::string& incoming) {
+    (void)incoming;  // 2Q reclaims independently of the incoming key
+    // Reclaim from A1in while it is over its share, otherwise from Am's tail
+    if (!a1in.empty() && (a1in.size() > kin || am.empty())) {
+        return a1in.back();
+    }
+    return am.back();
+}
+
+void TwoQueuePolicy::onInsert(size_t slot, const std::string& key) {
+    uint64_t hashed = policy_key_hash(key);
+    if (slot >= keys.size()) keys.resize(slot + 1, 0);
+    keys[slot] = hashed;
+
+    if (a1out.remove(hashed)) {
+        am.pushFront(slot);
+    } else {
+        a1in.pushFront(slot);
+    }
+}
+
+void TwoQueuePolicy::onAccess(size_t slot) {
+    // Hits in A1in are correlated references and leave the FIFO untouched
+    if (am.contains(slot)) {
+        am.pushFront(slot);
+    }
+}
+
+void TwoQueuePolicy::onRemove(size_t slot) {
+    if (a1in.contains(slot)) {
+        a1in.remove(slot);
+        a1out.pushFront(keys[slot]);
+        while (a1out.size() > kout) a1out.popBack();
+    } else {
+        am.remove(slot);
+    }
+}
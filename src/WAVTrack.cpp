@@ -1,11 +1,11 @@
 #include "WAVTrack.h"
-#include <iostream>
+#include "Logger.h"
 
 WAVTrack::WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
                    int duration, int bpm, int sample_rate, int bit_depth)
     : AudioTrack(title, artists, duration, bpm), sample_rate(sample_rate), bit_depth(bit_depth) {
 
-    std::cout << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
+    DJ_LOG(Info, Track) << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
 }
 
 // ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
@@ -14,17 +14,17 @@ void WAVTrack::load() {
     // TODO: Implement realistic WAV loading simulation
     // NOTE: Use exactly 2 spaces before the arrow (→) character
     
-std::cout << "[WAVTrack::load] Loading WAV: \"" << title 
+DJ_LOG(Info, Track) << "[WAVTrack::load] Loading WAV: \"" << title 
               << "\" at " << sample_rate << "Hz/" << bit_depth << "bit (uncompressed)...\n";
 
 long long file_size = (long long)duration_seconds * sample_rate * (bit_depth / 8) * 2;
 
-std::cout << "  → Estimated file size: " << file_size << " bytes\n";
-std::cout << "  → Fast loading due to uncompressed format.\n";
+DJ_LOG(Info, Track) << "  → Estimated file size: " << file_size << " bytes\n";
+DJ_LOG(Info, Track) << "  → Fast loading due to uncompressed format.\n";
 }
 
 void WAVTrack::analyze_beatgrid() {
-    std::cout << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
+    DJ_LOG(Info, Track) << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
     // TODO: Implement WAV-specific beat detection analysis
     // Requirements:
     // 1. Print analysis message with track title
@@ -34,8 +34,10 @@ void WAVTrack::analyze_beatgrid() {
 
     double beats_estimated = (static_cast<double>(duration_seconds) / 60.0) * bpm;
     
-    std::cout << "  → Estimated beats: " << int(beats_estimated) 
+    DJ_LOG(Info, Track) << "  → Estimated beats: " << int(beats_estimated) 
               << " → Precision factor: 1 (uncompressed audio)" << std::endl;
+    get_beatgrid();   // tracked once per waveform, then served from the analysis cache
+    DJ_LOG(Debug, Track) << "  → " << describe_beatgrid() << std::endl;   // shown with --beatgrids
 }
 
 double WAVTrack::get_quality_score() const {
@@ -67,6 +69,6 @@ double WAVTrack::get_quality_score() const {
 
 PointerWrapper<AudioTrack> WAVTrack::clone() const {
     // Creates a new WAVTrack object using the WAVTrack Copy Constructor.
-    // The base class AudioTrack's deep copy logic ensures waveform_data is copied.
+    // The base class AudioTrack's copy shares the waveform (copy-on-write).
     return PointerWrapper<AudioTrack>(new WAVTrack(*this));
 }
\ No newline at end of file
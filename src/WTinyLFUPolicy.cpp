@@ -0,0 +1,86 @@
+#include "WTinyLFUPolicy.h"
+#include <algorithm>
+
+WTinyLFUPolicy::WTinyLFUPolicy(size_t capacity)
+    : capacity(0), window_capacity(1), protected_capacity(0), window(), probation(),
+      protected_list(), sketch(), keys() {
+    reset(capacity);
+}
+
+void WTinyLFUPolicy::reset(size_t new_capacity) {
+    capacity = new_capacity;
+    window_capacity = std::max<size_t>(capacity / 100, 1);
+    size_t main_capacity = capacity > window_capacity ? capacity - window_capacity : 0;
+    protected_capacity = main_capacity * 8 / 10;
+    window.reset(capacity);
+    probation.reset(capacity);
+    protected_list.reset(capacity);
+    sketch.reset(capacity);
+    keys.assign(capacity, 0);
+}
+
+size_t WTinyLFUPolicy::mainVictim() const {
+    if (!probation.empty()) return probation.back();
+    if (!protected_list.empty()) return protected_list.back();
+    return window.back();
+}
+
+size_t WTinyLFUPolicy::selectVictim(const std::string& incoming) {
+    (void)incoming;  // the newcomer always enters the window
+    if (window.size() < window_capacity || window.empty()) {
+        return mainVictim();
+    }
+
+    // The window is full: its LRU candidate competes with the main victim
+    size_t candidate = window.back();
+    if (probation.empty() && protected_list.empty()) {
+        return candidate;
+    }
+    size_t victim = mainVictim();
+    if (sketch.estimate(keys[candidate]) > sketch.estimate(keys[victim])) {
+        window.remove(candidate);
+        probation.pushFront(candidate);
+        return victim;
+    }
+    return candidate;
+}
+
+void WTinyLFUPolicy::onInsert(size_t slot, const std::string& key) {
+    uint64_t hashed = policy_key_hash(key);
+    if (slot >= keys.size()) keys.resize(slot + 1, 0);
+    keys[slot] = hashed;
+    sketch.increment(hashed);
+
+    window.pushFront(slot);
+    // While the cache is filling, window overflow moves straight to probation
+    if (window.size() > window_capacity) {
+        size_t overflow = window.back();
+        window.remove(overflow);
+        probation.pushFront(overflow);
+    }
+}
+
+void WTinyLFUPolicy::onAccess(size_t slot) {
+    sketch.increment(keys[slot]);
+
+    if (window.contains(slot)) {
+        window.pushFront(slot);
+    } else if (probation.contains(slot)) {
+        // Promote; demote protected's LRU if the segment overflows
+        probation.remove(slot);
+        protected_list.pushFront(slot);
+        if (protected_list.size() > protected_capacity && protected_list.size() > 1) {
+            size_t demoted = protected_list.back();
+            protected_list.remove(demoted);
+            probation.pushFront(demoted);
+        }
+    } else {
+        protected_list.pushFront(slot);
+    }
+}
+
+void WTinyLFUPolicy::onRemove(size_t slot) {
+    window.remove(slot);
+    probation.remove(slot);
+    protected_list.remove(slot);
+}
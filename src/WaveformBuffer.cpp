@@ -0,0 +1,164 @@
+#include "WaveformBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+std::atomic<size_t> WaveformBuffer::allocations(0);
+
+WaveformBuffer::Block::Block(size_t size)
+    : refs(1), size(size), samples(new double[size]()), seed(0), lazy(false), generated(), hash(0) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+WaveformBuffer::Block::Block(size_t size, uint64_t seed)
+    : refs(1), size(size), samples(nullptr), seed(seed), lazy(true), generated(), hash(0) {}
+
+WaveformBuffer::Block::~Block() {
+    delete[] samples;
+}
+
+WaveformBuffer::WaveformBuffer() : block(nullptr) {}
+
+WaveformBuffer::WaveformBuffer(size_t size) : block(size ? new Block(size) : nullptr) {}
+
+WaveformBuffer WaveformBuffer::synthesized(size_t size, uint64_t seed) {
+    WaveformBuffer buffer;
+    if (size) buffer.block = new Block(size, seed);
+    return buffer;
+}
+
+double WaveformBuffer::synthetic_sample(uint64_t seed, size_t i) {
+    uint64_t z = seed + (static_cast<uint64_t>(i) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    // Top 53 bits -> [0, 1) -> [-1, 1)
+    return static_cast<double>(z >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+void WaveformBuffer::materialize(Block* block) {
+    if (!block || !block->lazy) return;
+    std::call_once(block->generated, [block]() {
+        double* samples = new double[block->size];
+        for (size_t i = 0; i < block->size; ++i) {
+            samples[i] = synthetic_sample(block->seed, i);
+        }
+        block->samples = samples;
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+const double* WaveformBuffer::data() const {
+    if (!block) return nullptr;
+    materialize(block);
+    return block->samples;
+}
+
+void WaveformBuffer::read(size_t offset, double* out, size_t count) const {
+    size_t available = offset < size() ? std::min(count, size() - offset) : 0;
+    if (available && block->lazy) {
+        // Same values as the generated samples, without touching them
+        for (size_t i = 0; i < available; ++i) {
+            out[i] = synthetic_sample(block->seed, offset + i);
+        }
+    } else if (available) {
+        std::memcpy(out, block->samples + offset, available * sizeof(double));
+    }
+    std::fill(out + available, out + count, 0.0);
+}
+
+uint64_t WaveformBuffer::content_hash() const {
+    if (!block) return 0;
+    uint64_t hash = block->hash.load(std::memory_order_relaxed);
+    if (hash) return hash;
+
+    // FNV-1a over the size and the bit patterns of the samples, then a
+    // splitmix64 finalizer; racing threads compute and store the same value
+    hash = 14695981039346656037ULL;
+    hash = (hash ^ block->size) * 1099511628211ULL;
+    const size_t CHUNK = 256;
+    double chunk[CHUNK];
+    for (size_t offset = 0; offset < block->size; offset += CHUNK) {
+        size_t count = std::min(CHUNK, block->size - offset);
+        read(offset, chunk, count);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t bits;
+            std::memcpy(&bits, &chunk[i], sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ULL;
+        }
+    }
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    hash = hash ? hash : 1;   // 0 means "not computed"
+    block->hash.store(hash, std::memory_order_relaxed);
+    return hash;
+}
+
+bool WaveformBuffer::is_materialized() const {
+    return block && block->samples != nullptr;
+}
+
+WaveformBuffer::~WaveformBuffer() {
+    release();
+}
+
+WaveformBuffer::WaveformBuffer(const WaveformBuffer& other) : block(other.block) {
+    if (block) block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+WaveformBuffer& WaveformBuffer::operator=(const WaveformBuffer& other) {
+    if (block == other.block) {
+        return *this;
+    }
+    // Take the new reference before dropping the old one
+    if (other.block) other.block->refs.fetch_add(1, std::memory_order_relaxed);
+    release();
+    block = other.block;
+    return *this;
+}
+
+WaveformBuffer::WaveformBuffer(WaveformBuffer&& other) noexcept : block(other.block) {
+    other.block = nullptr;
+}
+
+WaveformBuffer& WaveformBuffer::operator=(WaveformBuffer&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    release();
+    block = other.block;
+    other.block = nullptr;
+    return *this;
+}
+
+void WaveformBuffer::release() {
+    // acq_rel so the last owner sees every write made through other handles
+    if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete block;
+    }
+    block = nullptr;
+}
+
+double* WaveformBuffer::mutable_data() {
+    if (!block) return nullptr;
+    materialize(block);
+    if (block->refs.load(std::memory_order_acquire) > 1) {
+        // Shared: detach into a private copy before the caller writes
+        Block* copy = new Block(block->size);
+        std::memcpy(copy->samples, block->samples, block->size * sizeof(double));
+        release();
+        block = copy;
+    }
+    // Unshared from here on: the samples may stop matching the seed
+    block->lazy = false;
+    block->hash.store(0, std::memory_order_relaxed);
+    return block->samples;
+}
+
+size_t WaveformBuffer::use_count() const {
+    return block ? block->refs.load(std::memory_order_relaxed) : 0;
+}
+
+size_t WaveformBuffer::allocation_count() {
+    return allocations.load(std::memory_order_relaxed);
+}
@@ -1,6 +1,12 @@
-#include <iostream>
+#include "Logger.h"
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 // Include all our classes
 #include "AudioTrack.h"
@@ -13,6 +19,14 @@
 #include "DJControllerService.h"
 #include "MixingEngineService.h"
 #include "PointerWrapper.h"
+#include "WaveformBuffer.h"
+#include "LibraryGenerator.h"
+#include "LibrarySnapshot.h"
+#include "MixKernels.h"
+#include "AnalysisCache.h"
+#include "ThreadPool.h"
+#include "LibraryAnalyzer.h"
+#include "LatencyHistogram.h"
 /**
  * DJ Track Session Manager - Test Program
  * 
@@ -26,16 +40,16 @@
 bool del = false; // hint: what is the purpose of this variable? how it changes the ownership semantics?
 void test_phase_1_memory_leaks() {
     
-    std::cout << "\n======== PHASE 1: MEMORY LEAK TESTING ========" << std::endl;
-    std::cout << "Testing the broken Playlist class..." << std::endl;
+    DJ_LOG(Info, App) << "\n======== PHASE 1: MEMORY LEAK TESTING ========" << std::endl;
+    DJ_LOG(Info, App) << "Testing the broken Playlist class..." << std::endl;
 
     // Create some tracks (these will leak if AudioTrack Rule of 5 isn't implemented)
-    std::cout << "Creating tracks..." << std::endl;
+    DJ_LOG(Info, App) << "Creating tracks..." << std::endl;
     AudioTrack* mp3 = new MP3Track("Sunset Lover", {"Petit Biscuit"}, 180, 120, 320);
     AudioTrack* wav = new WAVTrack("Strobe", {"Deadmau5"}, 645, 128, 44100, 16);
 
     // Create playlist and add tracks (this will leak nodes if destructor is broken)
-    std::cout << "Creating playlist..." << std::endl;
+    DJ_LOG(Info, App) << "Creating playlist..." << std::endl;
     Playlist* my_playlist = new Playlist("Chill House Mix");
 
     my_playlist->add_track(mp3);
@@ -43,99 +57,99 @@ void test_phase_1_memory_leaks() {
     my_playlist->display();
 
     // Remove a track (this will leak if remove_track is broken)
-    std::cout << "Removing track..." << std::endl;
+    DJ_LOG(Info, App) << "Removing track..." << std::endl;
     my_playlist->remove_track("Strobe");
     my_playlist->display();
 
-    std::cout << "Cleaning up..." << std::endl;
+    DJ_LOG(Info, App) << "Cleaning up..." << std::endl;
     delete my_playlist;  // Should clean up playlist nodes
     if(del){
         delete mp3;          // Should clean up AudioTrack data
         delete wav;          // Should clean up AudioTrack data
     }
 
-    std::cout << "Phase 1 test complete. Check for memory leaks!\n" << std::endl;
+    DJ_LOG(Info, App) << "Phase 1 test complete. Check for memory leaks!\n" << std::endl;
 }
 
 void test_phase_2_rule_of_5() {
-    std::cout << "\n======== PHASE 2: RULE OF 5 TESTING ========" << std::endl;
-    std::cout << "Testing AudioTrack copy and move operations..." << std::endl;
+    DJ_LOG(Info, App) << "\n======== PHASE 2: RULE OF 5 TESTING ========" << std::endl;
+    DJ_LOG(Info, App) << "Testing AudioTrack copy and move operations..." << std::endl;
 
     try {
         // Test copy constructor
-        std::cout << "Testing copy constructor..." << std::endl;
+        DJ_LOG(Info, App) << "Testing copy constructor..." << std::endl;
         MP3Track original("Original Track", {"Test Artist"}, 200, 128, 256);
         MP3Track copied = original;  // Should call copy constructor
 
-        std::cout << "Original: " << original.get_title() << std::endl;
-        std::cout << "Copied: " << copied.get_title() << std::endl;
+        DJ_LOG(Info, App) << "Original: " << original.get_title() << std::endl;
+        DJ_LOG(Info, App) << "Copied: " << copied.get_title() << std::endl;
 
         // Test copy assignment
-        std::cout << "\nTesting copy assignment..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting copy assignment..." << std::endl;
         MP3Track assigned("Temporary Track", {"Temp Artist"}, 100, 120, 128);
         assigned = original;  // Should call copy assignment
 
-        std::cout << "Assigned: " << assigned.get_title() << std::endl;
+        DJ_LOG(Info, App) << "Assigned: " << assigned.get_title() << std::endl;
 
         // Test move constructor
-        std::cout << "\nTesting move constructor..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting move constructor..." << std::endl;
         MP3Track moved = std::move(original);  // Should call move constructor
 
-        std::cout << "Moved: " << moved.get_title() << std::endl;
+        DJ_LOG(Info, App) << "Moved: " << moved.get_title() << std::endl;
 
-        std::cout << "Phase 2 test complete!\n" << std::endl;
+        DJ_LOG(Info, App) << "Phase 2 test complete!\n" << std::endl;
 
     } catch (const std::exception& e) {
-        std::cout << "❌ Exception caught: " << e.what() << std::endl;
-        std::cout << "This indicates Rule of 5 implementation issues!\n" << std::endl;
+        DJ_LOG(Info, App) << "❌ Exception caught: " << e.what() << std::endl;
+        DJ_LOG(Info, App) << "This indicates Rule of 5 implementation issues!\n" << std::endl;
     }
 }
 
 void test_phase_3() {
-    std::cout << "\n======== PHASE 3: SMART POINTER TESTING ========" << std::endl;
-    std::cout << "Testing DJUniquePtr implementation..." << std::endl;
+    DJ_LOG(Info, App) << "\n======== PHASE 3: SMART POINTER TESTING ========" << std::endl;
+    DJ_LOG(Info, App) << "Testing DJUniquePtr implementation..." << std::endl;
 
     try {
         // Test basic construction
-        std::cout << "Testing DJUniquePtr construction..." << std::endl;
+        DJ_LOG(Info, App) << "Testing DJUniquePtr construction..." << std::endl;
         PointerWrapper<MP3Track> smart_track(new MP3Track("Smart Track", {"AI Artist"}, 240, 130, 320));
 
         // Test access operators (will be TODO messages initially)
-        std::cout << "\nTesting access operators..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting access operators..." << std::endl;
         if (smart_track) {
-            std::cout << "Smart pointer contains: " << smart_track->get_title() << std::endl;
-            std::cout << "BPM: " << (*smart_track).get_bpm() << std::endl;
+            DJ_LOG(Info, App) << "Smart pointer contains: " << smart_track->get_title() << std::endl;
+            DJ_LOG(Info, App) << "BPM: " << (*smart_track).get_bpm() << std::endl;
         }
 
         // Test move operations
-        std::cout << "\nTesting move operations..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting move operations..." << std::endl;
         PointerWrapper<MP3Track> moved_track = std::move(smart_track);
-        std::cout << "Original pointer after move: " << (smart_track ? "still valid" : "null") << std::endl;
-        std::cout << "Moved pointer: " << (moved_track ? "valid" : "null") << std::endl;
+        DJ_LOG(Info, App) << "Original pointer after move: " << (smart_track ? "still valid" : "null") << std::endl;
+        DJ_LOG(Info, App) << "Moved pointer: " << (moved_track ? "valid" : "null") << std::endl;
 
         // Test reset
-        std::cout << "\nTesting reset..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting reset..." << std::endl;
         moved_track.reset(new MP3Track("Reset Track", {"Reset Artist"}, 180, 125, 256));
 
         // Test release
-        std::cout << "\nTesting release..." << std::endl;
+        DJ_LOG(Info, App) << "\nTesting release..." << std::endl;
         MP3Track* raw_ptr = moved_track.release();
-        std::cout << "Released pointer: " << (raw_ptr ? raw_ptr->get_title() : "null") << std::endl;
+        DJ_LOG(Info, App) << "Released pointer: " << (raw_ptr ? raw_ptr->get_title() : "null") << std::endl;
 
         // Manual cleanup since we released
         delete raw_ptr;
 
-        std::cout << "Phase 3 test complete!\n" << std::endl;
+        DJ_LOG(Info, App) << "Phase 3 test complete!\n" << std::endl;
 
     } catch (const std::exception& e) {
-        std::cout << "❌ Exception caught: " << e.what() << std::endl;
-        std::cout << "This indicates DJUniquePtr implementation issues!\n" << std::endl;
+        DJ_LOG(Info, App) << "❌ Exception caught: " << e.what() << std::endl;
+        DJ_LOG(Info, App) << "This indicates DJUniquePtr implementation issues!\n" << std::endl;
     }
 }
 
 void demonstrate_polymorphism() {
-    std::cout << "\n======== POLYMORPHISM DEMONSTRATION ========" << std::endl;
-    std::cout << "Showing virtual function calls with different track types...\n" << std::endl;
+    DJ_LOG(Info, App) << "\n======== POLYMORPHISM DEMONSTRATION ========" << std::endl;
+    DJ_LOG(Info, App) << "Showing virtual function calls with different track types...\n" << std::endl;
 
     // Create different track types
     std::vector<std::unique_ptr<AudioTrack>> tracks;
@@ -144,25 +158,632 @@ void demonstrate_polymorphism() {
 
     // Call virtual functions polymorphically
     for (auto& track : tracks) {
-        std::cout << "Track: " << track->get_title() << std::endl;
+        DJ_LOG(Info, App) << "Track: " << track->get_title() << std::endl;
         track->load();                    // Virtual function call
         track->analyze_beatgrid();        // Virtual function call
-        std::cout << "Quality: " << track->get_quality_score() << std::endl;  // Virtual function call
+        DJ_LOG(Info, App) << "Quality: " << track->get_quality_score() << std::endl;  // Virtual function call
 
         // Test cloning
         auto cloned = track->clone();
         if (cloned) {
-            std::cout << "Cloned: " << cloned->get_title() << std::endl;
+            DJ_LOG(Info, App) << "Cloned: " << cloned->get_title() << std::endl;
         }
-        std::cout << std::endl;
+        DJ_LOG(Info, App) << std::endl;
     }
 }
+void test_playlist_duplicates() {
+    DJ_LOG(Info, App) << "\n======== PLAYLIST DUPLICATE TITLE TESTING ========" << std::endl;
+
+    // Three tracks share a title; lookups and removals act on the latest one added
+    Playlist playlist("Duplicates");
+    playlist.add_track(TrackHandle(new MP3Track("Echo", {"First"}, 200, 120, 320)));
+    playlist.add_track(TrackHandle(new MP3Track("Bridge", {"Other"}, 210, 122, 320)));
+    playlist.add_track(TrackHandle(new MP3Track("Echo", {"Second"}, 220, 124, 320)));
+    playlist.add_track(TrackHandle(new MP3Track("Echo", {"Third"}, 230, 126, 320)));
+    DJ_LOG(Info, App) << "Found 'Echo' by: " << playlist.find_track("Echo")->get_artists()[0] << std::endl;
+    playlist.remove_track("Echo");
+    DJ_LOG(Info, App) << "After one removal: " << playlist.find_track("Echo")->get_artists()[0] << std::endl;
+    playlist.remove_track("Bridge");
+    playlist.remove_track("Echo");
+    DJ_LOG(Info, App) << "After two removals: " << playlist.find_track("Echo")->get_artists()[0]
+              << ", 'Bridge' " << (playlist.find_track("Bridge") ? "still found" : "gone") << std::endl;
+    playlist.remove_track("Echo");
+    DJ_LOG(Info, App) << "After three removals: " << (playlist.find_track("Echo") ? "still found" : "gone")
+              << ", " << playlist.get_track_count() << " tracks left" << std::endl;
+    DJ_LOG(Info, App) << "Playlist duplicate test complete!\n" << std::endl;
+}
+
+void test_waveform_sharing() {
+    DJ_LOG(Info, App) << "\n======== COPY-ON-WRITE WAVEFORM TESTING ========" << std::endl;
+    DJ_LOG(Info, App) << "Counting waveform allocations along library -> playlist -> cache -> deck..." << std::endl;
+
+    size_t at_start = WaveformBuffer::allocation_count();
+    MP3Track library_track("Shared Waveform", {"Test Artist"}, 210, 128, 320);
+    DJ_LOG(Info, App) << "Waveform allocations at construction (lazy): "
+              << (WaveformBuffer::allocation_count() - at_start) << std::endl;
+
+    // First read generates the samples once for the track and all its clones
+    double first_samples[4] = {0, 0, 0, 0};
+    library_track.get_waveform_copy(first_samples, 4);
+    MP3Track twin("Shared Waveform", {"Test Artist"}, 210, 128, 320);
+    double twin_samples[4] = {0, 0, 0, 0};
+    twin.get_waveform_copy(twin_samples, 4);
+    DJ_LOG(Info, App) << "Same identity gives same waveform: "
+              << (std::equal(first_samples, first_samples + 4, twin_samples) ? "yes" : "no") << std::endl;
+    size_t before = WaveformBuffer::allocation_count();
+
+    // A chain of three clones still shares one sample array
+    PointerWrapper<AudioTrack> playlist_copy = library_track.clone();
+    PointerWrapper<AudioTrack> cache_copy = playlist_copy->clone();
+    PointerWrapper<AudioTrack> deck_copy = cache_copy->clone();
+
+    size_t after_clones = WaveformBuffer::allocation_count();
+    DJ_LOG(Info, App) << "Waveform allocations for 3 clones: " << (after_clones - before) << std::endl;
+    DJ_LOG(Info, App) << "Clones share samples: "
+              << (deck_copy->get_waveform_data() == library_track.get_waveform_data() ? "yes" : "no")
+              << std::endl;
+
+    // Writing to one clone detaches only that clone
+    deck_copy->get_mutable_waveform()[0] = 0.0;
+    size_t after_write = WaveformBuffer::allocation_count();
+    DJ_LOG(Info, App) << "Waveform allocations after modifying the deck copy: " << (after_write - after_clones) << std::endl;
+    DJ_LOG(Info, App) << "Cache copy still shares with library: "
+              << (cache_copy->get_waveform_data() == library_track.get_waveform_data() ? "yes" : "no")
+              << std::endl;
+    DJ_LOG(Info, App) << "Copy-on-write test complete!\n" << std::endl;
+}
+
+/**
+ * -G <output> <tracks> <playlists> [min_length] [max_length] [zipf_exponent] [seed]
+ */
+int generate_config(int argc, char* argv[]) {
+    if (argc < 5) {
+        DJ_LOG_ERR(Error, App) << "Usage: " << argv[0]
+                               << " -G <output> <tracks> <playlists> [min_length] [max_length] [zipf_exponent] [seed]"
+                               << std::endl;
+        return 1;
+    }
+    LibraryGenerator::Options options;
+    try {
+        options.tracks = std::stoull(argv[3]);
+        options.playlists = std::stoull(argv[4]);
+        if (argc > 5) options.min_playlist_length = std::stoull(argv[5]);
+        options.max_playlist_length = argc > 6 ? std::stoull(argv[6])
+                                               : std::max(options.min_playlist_length, options.max_playlist_length);
+        if (argc > 7) options.zipf_exponent = std::stod(argv[7]);
+        if (argc > 8) options.seed = std::stoull(argv[8]);
+    } catch (const std::exception& e) {
+        DJ_LOG_ERR(Error, App) << "[ERROR] Invalid generator argument: " << e.what() << std::endl;
+        return 1;
+    }
+    return LibraryGenerator::write_config(argv[2], options) ? 0 : 1;
+}
+
+void test_bpm_index() {
+    DJ_LOG(Info, App) << "\n======== BPM INDEX TESTING ========" << std::endl;
+
+    std::vector<SessionConfig::TrackInfo> tracks;
+    const char* types[] = {"MP3", "WAV", "MP3", "WAV", "MP3", "MP3"};
+    const int bpms[] = {120, 126, 128, 129, 135, 127};
+    const int extra1[] = {320, 44100, 128, 96000, 320, 192};
+    const int extra2[] = {1, 16, 0, 24, 1, 1};
+    for (size_t i = 0; i < 6; ++i) {
+        SessionConfig::TrackInfo info;
+        info.type = types[i];
+        info.title = "Index Track " + std::to_string(i + 1);
+        info.artists.push_back("Index Artist");
+        info.duration_seconds = 200;
+        info.bpm = bpms[i];
+        info.extra_param1 = extra1[i];
+        info.extra_param2 = extra2[i];
+        tracks.push_back(info);
+    }
+    DJLibraryService library;
+    library.buildLibrary(tracks);
+
+    DJ_LOG(Info, App) << "Tracks within 2 BPM of 128: " << library.getBpmIndex().count(126, 130) << std::endl;
+    DJ_LOG(Info, App) << "Suggestions for a deck at 128 BPM (tolerance 3):" << std::endl;
+    std::vector<TrackHandle> suggestions = library.findCompatibleTracks(128, 3);
+    for (const TrackHandle& track : suggestions) {
+        DJ_LOG(Info, App) << "  " << track->get_title() << " (" << track->get_bpm() << " BPM, quality "
+                  << track->get_quality_score() << ")" << std::endl;
+    }
+    DJ_LOG(Info, App) << "WAV suggestions with quality >= 95:" << std::endl;
+    suggestions = library.findCompatibleTracks(128, 10, BpmIndex::Filter(TrackKind::WAV, 95.0));
+    for (const TrackHandle& track : suggestions) {
+        DJ_LOG(Info, App) << "  " << track->get_title() << " (" << track->get_bpm() << " BPM, quality "
+                  << track->get_quality_score() << ")" << std::endl;
+    }
+    DJ_LOG(Info, App) << "BPM index test complete!\n" << std::endl;
+}
+
+void test_search_index() {
+    DJ_LOG(Info, App) << "\n======== TRACK SEARCH TESTING ========" << std::endl;
+
+    std::vector<SessionConfig::TrackInfo> tracks;
+    const char* titles[] = {"Summer Nights", "Night Drive", "Summertime Blues", "Levitating"};
+    const char* artists[][2] = {{"Nova", "Kite"}, {"Kite", ""}, {"Nova", ""}, {"Dua Lipa", "DaBaby"}};
+    for (size_t i = 0; i < 4; ++i) {
+        SessionConfig::TrackInfo info;
+        info.type = "MP3";
+        info.title = titles[i];
+        for (const char* artist : artists[i]) {
+            if (*artist) info.artists.push_back(artist);
+        }
+        info.duration_seconds = 200;
+        info.bpm = 120;
+        info.extra_param1 = 320;
+        info.extra_param2 = 1;
+        tracks.push_back(info);
+    }
+    DJLibraryService library;
+    library.buildLibrary(tracks);
+
+    const char* queries[] = {"summer", "NIGHT", "summer nig", "dua li"};
+    for (const char* query : queries) {
+        DJ_LOG(Info, App) << "Search '" << query << "':";
+        for (const TrackHandle& track : library.searchTracks(query)) {
+            DJ_LOG(Info, App) << " [" << track->get_title() << "]";
+        }
+        DJ_LOG(Info, App) << std::endl;
+    }
+    DJ_LOG(Info, App) << "Tracks by Nova and Kite:";
+    for (const TrackHandle& track : library.findTracksByArtists({"Nova", "Kite"})) {
+        DJ_LOG(Info, App) << " [" << track->get_title() << "]";
+    }
+    DJ_LOG(Info, App) << std::endl;
+    DJ_LOG(Info, App) << "Completions for 'su':";
+    for (const std::string& word : library.completeSearch("su")) {
+        DJ_LOG(Info, App) << " " << word;
+    }
+    DJ_LOG(Info, App) << std::endl;
+
+    // Opting out drops the index; a search then reports the error
+    library.setSearchIndexing(false);
+    DJ_LOG(Info, App) << "With indexing off: " << library.searchTracks("summer").size() << " results" << std::endl;
+    DJ_LOG(Info, App) << "Track search test complete!\n" << std::endl;
+}
+
+void test_deck_preload() {
+    DJ_LOG(Info, App) << "\n======== DECK PRELOAD TESTING ========" << std::endl;
+
+    TrackHandle opener(new MP3Track("Opening Set", {"Nova"}, 240, 124, 320));
+    TrackHandle next(new WAVTrack("Second Wind", {"Kite"}, 300, 126, 44100, 16));
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.loadTrackToDeck(*opener);
+
+    // Prepared in the background while the opener plays; the load is a swap
+    mixer.preloadTrack(next);
+    mixer.loadTrackToDeck(*next);
+    mixer.displayDeckStatus();
+
+    const AudioTrack* active = mixer.getDeckTrack(mixer.getActiveDeck());
+    DJ_LOG(Info, App) << "Active deck shares the library samples: "
+              << (active && active->get_waveform_data() == next->get_waveform_data() ? "yes" : "no") << std::endl;
+    DJ_LOG(Info, App) << "Deck preload test complete!\n" << std::endl;
+}
+
+void test_mix_render() {
+    DJ_LOG(Info, App) << "\n======== MIX RENDER TESTING ========" << std::endl;
+
+    MP3Track deck_a("Render A", {"Nova"}, 240, 124, 320);
+    WAVTrack deck_b("Render B", {"Kite"}, 240, 124, 44100, 16);
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.loadTrackToDeck(deck_a);
+    mixer.loadTrackToDeck(deck_b);
+
+    const size_t frames = 256;
+    std::vector<float> block(frames * MixingEngineService::OUTPUT_CHANNELS);
+    const float positions[] = {0.0f, 0.5f, 1.0f};
+    for (float position : positions) {
+        mixer.setCrossfader(position);
+        mixer.setDeckPosition(0, 0);
+        mixer.setDeckPosition(1, 0);
+        mixer.renderBlock(block.data(), frames);
+        double energy = 0.0;
+        for (float sample : block) {
+            energy += static_cast<double>(sample) * sample;
+        }
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2) << "Crossfader " << position
+             << ": RMS " << std::setprecision(4) << std::sqrt(energy / block.size());
+        DJ_LOG(Info, App) << line.str() << std::endl;
+    }
+    mixer.setDeckPosition(0, deck_a.get_waveform_size() - 10);
+    mixer.setDeckPosition(1, deck_b.get_waveform_size());
+    mixer.renderBlock(block.data(), frames);
+    DJ_LOG(Info, App) << "Samples past the end of both tracks are silent: "
+              << (std::count(block.begin() + 20, block.end(), 0.0f) == static_cast<long>(block.size() - 20) ? "yes" : "no")
+              << std::endl;
+    DJ_LOG(Info, App) << "Mix render test complete!\n" << std::endl;
+}
+
+/**
+ * Read exactly frames frames from the render thread, waiting for it as needed
+ */
+std::vector<float> read_rendered(MixingEngineService& mixer, size_t frames) {
+    std::vector<float> out(frames * MixingEngineService::OUTPUT_CHANNELS);
+    size_t done = 0;
+    while (done < frames) {
+        done += mixer.readRenderedFrames(&out[done * MixingEngineService::OUTPUT_CHANNELS], frames - done);
+        std::this_thread::yield();
+    }
+    return out;
+}
+
+void test_render_thread() {
+    DJ_LOG(Info, App) << "\n======== RENDER THREAD TESTING ========" << std::endl;
+
+    const size_t block = 16;
+    const size_t queued = 4;
+    MP3Track deck_a("Render A", {"Nova"}, 240, 124, 320);
+    WAVTrack deck_b("Render B", {"Kite"}, 240, 124, 44100, 16);
+    MixingEngineService direct, threaded;
+    for (MixingEngineService* mixer : {&direct, &threaded}) {
+        mixer->setRenderingEnabled(true);
+        mixer->loadTrackToDeck(deck_a);
+        mixer->loadTrackToDeck(deck_b);
+        mixer->setCrossfader(0.3f);
+    }
+
+    // Same settings, same blocks: the render thread must match renderBlock()
+    threaded.startRenderThread(block, queued);
+    std::vector<float> from_thread = read_rendered(threaded, 8 * block);
+    std::vector<float> expected(from_thread.size());
+    for (size_t i = 0; i < 8; ++i) {
+        direct.renderBlock(&expected[i * block * MixingEngineService::OUTPUT_CHANNELS], block);
+    }
+    DJ_LOG(Info, App) << "Render thread output matches renderBlock(): "
+              << (from_thread == expected ? "yes" : "no") << std::endl;
+
+    // A change lands at a block boundary after the blocks already queued
+    threaded.setCrossfader(1.0f);
+    threaded.setDeckGain(1, 0.0f);
+    std::vector<float> after = read_rendered(threaded, (queued + 2) * block);
+    size_t heard = 0;
+    while (heard < after.size() && after[heard] != 0.0f) {
+        heard += MixingEngineService::OUTPUT_CHANNELS;
+    }
+    heard /= MixingEngineService::OUTPUT_CHANNELS;
+    bool silent_after = std::all_of(after.begin() + heard * MixingEngineService::OUTPUT_CHANNELS, after.end(),
+                                    [](float sample) { return sample == 0.0f; });
+    DJ_LOG(Info, App) << "Mute heard on a block boundary within " << queued + 1 << " blocks: "
+              << (heard % block == 0 && heard <= (queued + 1) * block && silent_after ? "yes" : "no") << std::endl;
+
+    // Swap deck 0 while the render thread plays: the old track is freed later
+    WAVTrack deck_c("Render C", {"Vale"}, 240, 124, 44100, 16);
+    threaded.loadTrackToDeck(deck_c);
+    threaded.setCrossfader(0.0f);
+    const double* samples_c = deck_c.get_waveform_data();
+    std::vector<float> swapped = read_rendered(threaded, (queued + 4) * block);
+    size_t start = 0;
+    while (start < swapped.size() && swapped[start] == 0.0f) {
+        start += MixingEngineService::OUTPUT_CHANNELS;
+    }
+    size_t offset = 0;
+    while (offset < deck_c.get_waveform_size() && static_cast<float>(samples_c[offset]) != swapped[start]) {
+        ++offset;
+    }
+    bool contiguous = start < swapped.size();
+    for (size_t i = start, k = offset; i < swapped.size() && contiguous; i += 2, ++k) {
+        contiguous = k < deck_c.get_waveform_size() && swapped[i] == static_cast<float>(samples_c[k]) &&
+                     swapped[i + 1] == swapped[i];
+    }
+    DJ_LOG(Info, App) << "Swapped deck plays '" << threaded.getDeckTrack(0)->get_title()
+              << "' from a block boundary: " << (contiguous && offset % block == 0 ? "yes" : "no") << std::endl;
+
+    threaded.stopRenderThread();
+    DJ_LOG(Info, App) << "After stop: " << (threaded.isRenderThreadRunning() ? "running" : "stopped")
+              << ", deck 0 position is a whole number of blocks: "
+              << (threaded.getDeckPosition(0) % block == 0 ? "yes" : "no") << std::endl;
+    DJ_LOG(Info, App) << "Render thread test complete!\n" << std::endl;
+}
+
+void test_render_telemetry() {
+    DJ_LOG(Info, App) << "\n======== RENDER TELEMETRY TESTING ========" << std::endl;
+
+    // 1..10000 ns once each, from 4 threads: every bucket bound within 1/32
+    LatencyHistogram histogram;
+    {
+        ThreadPool pool(4);
+        pool.parallel_for(10000, 100, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                histogram.record(i + 1);
+            }
+        });
+    }
+    DJ_LOG(Info, App) << "Histogram: " << histogram.count() << " values, mean " << histogram.mean()
+              << " ns, p50 " << histogram.percentile(0.5) << " ns, p99 " << histogram.percentile(0.99)
+              << " ns, max " << histogram.max() << " ns" << std::endl;
+    bool bounded = true;
+    for (uint64_t ns = 1; ns < (uint64_t(1) << 40); ns = ns * 3 + 1) {
+        uint64_t high = LatencyHistogram::bucket_high(LatencyHistogram::bucket_index(ns));
+        bounded = bounded && high >= ns && high - ns <= ns / LatencyHistogram::SUB_BUCKETS;
+    }
+    DJ_LOG(Info, App) << "Bucket bounds within 1/" << LatencyHistogram::SUB_BUCKETS << " of the value: "
+              << (bounded ? "yes" : "no") << std::endl;
+    const LatencyHistogram::Summary summary = histogram.summary();
+    bool matches = summary.count == histogram.count() && summary.p50 == histogram.percentile(0.5)
+                   && summary.p999 == histogram.percentile(0.999) && summary.max == histogram.max();
+    DJ_LOG(Info, App) << "Summary matches the individual reads: " << (matches ? "yes" : "no") << std::endl;
+
+    MP3Track deck_a("Telemetry A", {"Nova"}, 240, 124, 320);
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.loadTrackToDeck(deck_a);
+    std::vector<float> out(64 * MixingEngineService::OUTPUT_CHANNELS);
+
+    // An impossible deadline: every block is an xrun; asking for more than
+    // the ring holds is an underrun
+    mixer.startRenderThread(16, 2, 1e12);
+    read_rendered(mixer, 8 * 16);
+    bool short_read = mixer.readRenderedFrames(out.data(), 64) < 64;
+    // A snapshot taken while blocks are recorded never counts a miss without its block
+    const MixingEngineService::RenderTelemetry live = mixer.getRenderTelemetry();
+    bool consistent = live.deadline_misses <= live.render_ns.count && live.render_ns.p99 <= live.render_ns.max;
+    mixer.stopRenderThread();
+    DJ_LOG(Info, App) << "Zero deadline: every block missed: "
+              << (mixer.getDeadlineMisses() == mixer.getRenderedBlocks() ? "yes" : "no")
+              << ", underrun counted: " << (short_read && mixer.getUnderruns() > 0 ? "yes" : "no")
+              << ", live snapshot consistent: " << (consistent ? "yes" : "no") << std::endl;
+
+    // A generous deadline (16 frames at 1 Hz): no misses, one timing per block
+    mixer.startRenderThread(16, 2, 1.0);
+    read_rendered(mixer, 8 * 16);
+    mixer.stopRenderThread();
+    DJ_LOG(Info, App) << "16 s deadline: " << mixer.getDeadlineMisses() << " misses, block timings recorded: "
+              << (mixer.getRenderTimes().count() == mixer.getRenderedBlocks() ? "all" : "some") << std::endl;
+    DJ_LOG(Info, App) << "Render telemetry test complete!\n" << std::endl;
+}
+
+void test_mix_kernels() {
+    DJ_LOG(Info, App) << "\n======== SIMD MIX KERNEL TESTING ========" << std::endl;
+
+    // Inputs beyond [-1, 1] so the clip kernel has work; odd lengths and offsets hit the tails
+    const size_t max_frames = 67;
+    std::vector<double> in0(max_frames + 1), in1(max_frames + 1);
+    for (size_t i = 0; i < in0.size(); ++i) {
+        in0[i] = 1.5 * WaveformBuffer::synthetic_sample(1, i);
+        in1[i] = 1.5 * WaveformBuffer::synthetic_sample(2, i);
+    }
+
+    const MixKernels* scalar = MixKernels::for_level(SimdLevel::Scalar);
+    const SimdLevel levels[] = {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    size_t mismatches = 0;
+    for (SimdLevel level : levels) {
+        const MixKernels* simd = MixKernels::for_level(level);
+        if (!simd) {
+            continue;    // not supported on this CPU
+        }
+        for (size_t frames = 0; frames <= max_frames; ++frames) {
+            for (size_t offset = 0; offset < 2; ++offset) {
+                const size_t n = frames - (frames ? offset : 0);
+                std::vector<float> expected(2 * max_frames + 1, 0.25f), actual(expected);
+                scalar->mix2_stereo(&expected[offset], &in0[offset], 0.7f, &in1[offset], 0.9f, n);
+                simd->mix2_stereo(&actual[offset], &in0[offset], 0.7f, &in1[offset], 0.9f, n);
+                scalar->add_stereo(&expected[offset], &in1[1], -0.3f, n);
+                simd->add_stereo(&actual[offset], &in1[1], -0.3f, n);
+                scalar->clip(&expected[0], 2 * n + offset, 1.0f);
+                simd->clip(&actual[0], 2 * n + offset, 1.0f);
+                mismatches += expected != actual;
+                scalar->store_stereo(&expected[offset], &in0[1], 1.2f, n);
+                simd->store_stereo(&actual[offset], &in0[1], 1.2f, n);
+                mismatches += expected != actual;
+            }
+        }
+    }
+    DJ_LOG(Info, App) << "SIMD kernels match the scalar reference bit for bit: "
+              << (mismatches == 0 ? "yes" : "no") << std::endl;
+    DJ_LOG(Info, App) << "SIMD mix kernel test complete!\n" << std::endl;
+}
+
+void test_time_stretch() {
+    DJ_LOG(Info, App) << "\n======== TIME STRETCH TESTING ========" << std::endl;
+
+    MP3Track opener("Stretch A", {"Nova"}, 240, 124, 320);
+    WAVTrack incoming("Stretch B", {"Kite"}, 240, 127, 44100, 16);
+    MixingEngineService mixer;
+    mixer.setRenderingEnabled(true);
+    mixer.set_auto_sync(true);
+    mixer.set_bpm_tolerance(5);
+    mixer.loadTrackToDeck(opener);
+    mixer.loadTrackToDeck(incoming);
+
+    std::vector<float> block(128 * MixingEngineService::OUTPUT_CHANNELS);
+    for (int i = 0; i < 4; ++i) {
+        mixer.renderBlock(block.data(), 128);
+    }
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2) << "Deck 1 plays at " << mixer.getDeckBpm(1)
+         << " BPM (tempo " << std::setprecision(4) << mixer.getDeckTempo(1) << ")";
+    DJ_LOG(Info, App) << line.str() << std::endl;
+    DJ_LOG(Info, App) << "Input samples per 512 output samples: deck 0 " << mixer.getDeckPosition(0)
+              << ", deck 1 " << mixer.getDeckPosition(1) << std::endl;
+    DJ_LOG(Info, App) << "Time stretch test complete!\n" << std::endl;
+}
+
+void test_beat_tracking() {
+    DJ_LOG(Info, App) << "\n======== BEAT TRACKING TESTING ========" << std::endl;
+
+    // 16 s at 8 kHz: a kick (click plus decaying 60 Hz body) every beat from 0.25 s at 126 BPM
+    const double sample_rate = 8000.0;
+    const double pi = std::acos(-1.0);
+    WaveformBuffer drums(static_cast<size_t>(16 * sample_rate));
+    double* samples = drums.mutable_data();
+    for (size_t i = 0; i < drums.size(); ++i) {
+        samples[i] = 0.05 * WaveformBuffer::synthetic_sample(7, i);
+    }
+    for (double beat = 0.25; beat < 16.0; beat += 60.0 / 126.0) {
+        size_t start = static_cast<size_t>(beat * sample_rate);
+        for (size_t k = 0; k < 1200 && start + k < drums.size(); ++k) {
+            double t = k / sample_rate;
+            samples[start + k] += 0.8 * std::exp(-25.0 * t) * std::sin(2.0 * pi * 60.0 * t)
+                                + (k < 24 ? 0.5 * WaveformBuffer::synthetic_sample(11, start + k) : 0.0);
+        }
+    }
+
+    // Clones and concurrent requests share one analysis
+    AnalysisCache cache;
+    WaveformBuffer clone = drums;
+    std::vector<const BeatGrid*> results(4, nullptr);
+    {
+        ThreadPool pool(4);
+        std::vector<std::future<void>> done;
+        for (size_t i = 0; i < results.size(); ++i) {
+            done.push_back(pool.submit([&, i]() {
+                results[i] = &cache.analyze(i % 2 ? clone : drums, sample_rate);
+            }));
+        }
+        for (auto& task : done) {
+            task.get();
+        }
+    }
+    const BeatGrid& grid = *results[0];
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1) << "Detected " << grid.bpm << " BPM, first beat at "
+         << std::setprecision(2) << grid.first_beat << " s, " << grid.beats << " beats";
+    DJ_LOG(Info, App) << line.str() << std::endl;
+    bool shared = std::all_of(results.begin(), results.end(), [&](const BeatGrid* r) { return r == &grid; });
+    DJ_LOG(Info, App) << "Analyses for 4 concurrent requests over 2 handles: " << cache.analyses()
+              << (shared ? " (one shared result)" : " (results differ)") << std::endl;
+
+    // A write detaches the clone: new content, new entry
+    clone.mutable_data()[0] += 0.5;
+    cache.analyze(clone, sample_rate);
+    DJ_LOG(Info, App) << "After writing to the clone: " << cache.size() << " entries, "
+              << cache.analyses() << " analyses" << std::endl;
+
+    // Library waveforms (1000 samples per track) are far below an audio rate,
+    // so they report an unavailable grid instead of running the tracker
+    MP3Track library_track("Coarse Grid", {"Nova"}, 240, 124, 320);
+    DJ_LOG(Info, App) << "Library track: " << library_track.describe_beatgrid()
+              << " (process-wide analyses: " << AnalysisCache::instance().analyses() << ")" << std::endl;
+    DJ_LOG(Info, App) << "Beat tracking test complete!\n" << std::endl;
+}
+
+void test_library_analysis() {
+    DJ_LOG(Info, App) << "\n======== LIBRARY ANALYSIS TESTING ========" << std::endl;
+
+    // Work stealing: the front of the range is much slower, so the workers
+    // that start at the back run out first and steal from it
+    const size_t count = 1000;
+    std::vector<int> visits(count, 0);
+    std::vector<double> work(count, 0.0);
+    ThreadPool pool(4);
+    pool.parallel_for(count, 8, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+            size_t spins = i < count / 4 ? 20000 : 100;
+            for (size_t k = 0; k < spins; ++k) {
+                work[i] += std::sqrt(static_cast<double>(k + i));
+            }
+        }
+    });
+    bool once = std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; });
+    DJ_LOG(Info, App) << "parallel_for over " << count << " indices on " << pool.size()
+              << " workers, each index run once: " << (once ? "yes" : "no") << std::endl;
+    try {
+        pool.parallel_for(count, 8, [](size_t begin, size_t end) {
+            if (begin <= 500 && 500 < end) {
+                throw std::runtime_error("index 500 failed");
+            }
+        });
+        DJ_LOG(Info, App) << "parallel_for exception: none" << std::endl;
+    } catch (const std::runtime_error& error) {
+        DJ_LOG(Info, App) << "parallel_for exception: " << error.what() << std::endl;
+    }
+
+    // One worker keeps the progress lines deterministic
+    std::vector<SessionConfig::TrackInfo> tracks;
+    for (size_t i = 0; i < 20; ++i) {
+        SessionConfig::TrackInfo info;
+        info.type = i % 2 ? "WAV" : "MP3";
+        info.title = "Analysis Track " + std::to_string(i + 1);
+        info.artists.push_back("Analysis Artist");
+        info.duration_seconds = 180;
+        info.bpm = 120 + static_cast<int>(i % 10);
+        info.extra_param1 = i % 2 ? 44100 : 256;
+        info.extra_param2 = i % 2 ? 16 : 1;
+        tracks.push_back(info);
+    }
+    DJLibraryService library;
+    library.buildLibrary(tracks);
+    size_t analyses_before = AnalysisCache::instance().analyses();
+    size_t grids = library.analyzeLibrary(1);
+
+    TrackHandle track = library.getLibraryTrack(0);
+    const TrackAnalysis& analysis = *track->get_analysis();
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3) << track->get_title() << ": quality " << analysis.quality
+         << ", peak " << analysis.peak << ", rms " << analysis.rms;
+    DJ_LOG(Info, App) << line.str() << std::endl;
+    DJ_LOG(Info, App) << "Grids detected: " << grids << ", waveform materialized: "
+              << (track->get_waveform().is_materialized() ? "yes" : "no") << std::endl;
+
+    // Clones share the stored analysis; writing to the samples drops it
+    PointerWrapper<AudioTrack> clone = track->clone();
+    bool carried = clone->get_analysis() == &analysis && &clone->get_beatgrid() == analysis.beatgrid;
+    clone->get_mutable_waveform()[0] = 0.0;
+    DJ_LOG(Info, App) << "Clone shares the analysis: " << (carried ? "yes" : "no")
+              << ", after a write: " << (clone->get_analysis() ? "kept" : "dropped")
+              << " (new analyses: " << AnalysisCache::instance().analyses() - analyses_before << ")" << std::endl;
+    DJ_LOG(Info, App) << "Library analysis test complete!\n" << std::endl;
+}
+
 int main(int argc, char* argv[]) {    
     /**
      * Command-line argument parsing
      * - If "-I" is provided as the first argument, run interactive DJ software
      * - If "-A" is provided as the second argument, enable play_all mode
+     * - "-G" writes a synthetic config (see generate_config)
+     * - "-S [config]" runs the non-interactive scale test on a config
+     * - "--snapshot" (trailing, with -I or -S) loads the library from
+     *   <config>.snap when it is current, and rebuilds it when it is not
+     * - "--analyze" (trailing, with -I or -S) analyzes the whole library in
+     *   parallel right after building it
+     * - "--render" (trailing, with -I) renders the mix on the render thread
+     *   and reports render deadlines, xruns and underruns in the summary
+     * - "--stats=<path>" (trailing, with -I or -S) also writes the summary
+     *   statistics as JSON to path
+     * - "--beatgrids" (trailing) also logs each track's tracked beat grid
+     *   under its estimated beats (Track category at Debug level)
      */
+    bool use_snapshot = false;
+    bool analyze_library = false;
+    bool live_render = false;
+    std::string stats_path;
+    for (; argc > 2; --argc) {
+        std::string option = argv[argc - 1];
+        if (option == "--snapshot") {
+            use_snapshot = true;
+        } else if (option == "--analyze") {
+            analyze_library = true;
+        } else if (option == "--render") {
+            live_render = true;
+        } else if (option.compare(0, 8, "--stats=") == 0) {
+            stats_path = option.substr(8);
+        } else if (option == "--beatgrids") {
+            Logger::set_category_level(LogCategory::Track, LogLevel::Debug);
+        } else {
+            break;
+        }
+    }
+    if (argc > 1 && std::string(argv[1]) == "-G") {
+        return generate_config(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "-S") {
+        Logger::set_quiet(true);
+        DJSession scale_session("Scale Test", true, argc > 2 ? argv[2] : "bin/dj_config.txt");
+        if (use_snapshot) {
+            scale_session.set_snapshot_path(LibrarySnapshot::path_for(argc > 2 ? argv[2] : "bin/dj_config.txt"));
+        }
+        scale_session.set_library_analysis(analyze_library);
+        scale_session.set_stats_path(stats_path);
+        return scale_session.run_scale_test() ? 0 : 1;
+    }
+
     bool run_software = false;
     bool play_all = false;
     if (argc > 1 && std::string(argv[1]) == "-I") {
@@ -174,24 +795,42 @@ int main(int argc, char* argv[]) {
     }
 
     if (run_software) {
-        std::cout << "\n============= RUNNING INTERACTIVE SOFTWARE =============" << std::endl;
+        DJ_LOG(Info, App) << "\n============= RUNNING INTERACTIVE SOFTWARE =============" << std::endl;
         DJSession live_session("Interactive Session", play_all);
+        if (use_snapshot) {
+            live_session.set_snapshot_path(LibrarySnapshot::path_for("bin/dj_config.txt"));
+        }
+        live_session.set_library_analysis(analyze_library);
+        live_session.set_live_render(live_render);
+        live_session.set_stats_path(stats_path);
         live_session.simulate_dj_performance();
-        std::cout << "============= INTERACTIVE SESSION ENDED =============\n" << std::endl;
+        DJ_LOG(Info, App) << "============= INTERACTIVE SESSION ENDED =============\n" << std::endl;
     } else {
-        std::cout << "==================================================" << std::endl;
-        std::cout << "    DJ TRACK SESSION MANAGER - TEST PROGRAM" << std::endl;
-        std::cout << "==================================================" << std::endl;
-        std::cout << "This program tests all phases of the assignment." << std::endl;
-        std::cout << "Initially, many features will be incomplete!" << std::endl;
-        std::cout << "==================================================" << std::endl;
+        DJ_LOG(Info, App) << "==================================================" << std::endl;
+        DJ_LOG(Info, App) << "    DJ TRACK SESSION MANAGER - TEST PROGRAM" << std::endl;
+        DJ_LOG(Info, App) << "==================================================" << std::endl;
+        DJ_LOG(Info, App) << "This program tests all phases of the assignment." << std::endl;
+        DJ_LOG(Info, App) << "Initially, many features will be incomplete!" << std::endl;
+        DJ_LOG(Info, App) << "==================================================" << std::endl;
         
         // Test each phase individually
         test_phase_1_memory_leaks();
         test_phase_2_rule_of_5();
         test_phase_3();
         demonstrate_polymorphism();
-        std::cout << "\n(Set 'run_software' to true in main.cpp to run the full interactive session.)\n" << std::endl;
+        test_playlist_duplicates();
+        test_waveform_sharing();
+        test_bpm_index();
+        test_search_index();
+        test_deck_preload();
+        test_mix_render();
+        test_render_thread();
+        test_render_telemetry();
+        test_mix_kernels();
+        test_time_stretch();
+        test_beat_tracking();
+        test_library_analysis();
+        DJ_LOG(Info, App) << "\n(Set 'run_software' to true in main.cpp to run the full interactive session.)\n" << std::endl;
     }
     return 0;
 }
\ No newline at end of file